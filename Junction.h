@@ -19,8 +19,13 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 // Defines a base class for all junctions.
 
+#include "JunctionAllocator.h"
+
 #include <initializer_list>
 #include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // Provides a way to recognise a Junction without needing to think about
 // templates:
@@ -33,16 +38,46 @@ class Junction;
 namespace Details {
 
 class UntemplatedJunctionTag {
-    UntemplatedJunctionTag() { }
+    constexpr UntemplatedJunctionTag() { }
 
     template<typename T>
     friend class ::P6::Junction;
 };
 
+// Helper functions pass this as the first argument to a junction's constructor
+// to have the remaining arguments forwarded to the store's constructor
+// untouched, as when a store needs an allocator as well as the elements:
+
+struct InPlaceTag { };
+InPlaceTag constexpr in_place {};
+
+// A store can pass something on to the junctions made by applying a lambda to
+// it, as JunctionInternStore passes on its intern table, by providing a
+// MappedContext() method.  The results are then built in place from the new
+// elements and the context if the result's store accepts them, and from the
+// new elements alone otherwise.
+
+template<typename Store>
+Store StoreOfJunction(Junction<Store> const *);
+
+template<typename Subclass, typename Store, typename Elements>
+auto MakeMapped(Store const &store, Elements &&new_elements, int)
+    -> typename std::enable_if<std::is_constructible<decltype(StoreOfJunction(static_cast<Subclass const *> (nullptr))),
+                                                     Elements &&, decltype(store.MappedContext())>::value,
+                               Subclass>::type {
+    return Subclass(in_place, std::move(new_elements), store.MappedContext());
+}
+
+template<typename Subclass, typename Store, typename Elements>
+Subclass MakeMapped(Store const &, Elements &&new_elements, long) {
+    Subclass result(std::move(new_elements));
+    return result;
+}
+
 } // Out of namespace Details
 
 // Here's the base class itself.  "Store" will be JunctionPiggyBackStore if
-// we're constructed via xxx_ref; for xxx_copy(), it's JunctionSortedStore,
+// we're constructed via xxx_ref; for xxx_copy(), it's JunctionFlatSortedStore,
 // which copies all the elements in O(N log N) time and linear space.
 
 template<typename Store>
@@ -61,25 +96,32 @@ protected:
     template<typename Container>
     Junction(Container const &container): Store(container)   { }
 
-    template<typename Elem>
-    Junction(std::set<Elem> &&container): Store(std::move(container))   { }
+    template<typename Elem, typename Less, typename Allocator>
+    Junction(std::set<Elem, Less, Allocator> &&container): Store(std::move(container))   { }
+
+    template<typename Elem, typename Allocator>
+    Junction(std::vector<Elem, Allocator> &&container): Store(std::move(container))   { }
+
+    template<typename... Args>
+    constexpr Junction(Details::InPlaceTag, Args &&...args): Store(std::forward<Args>(args)...)   { }
 
     template<typename Iterator>
     Junction(Iterator const begin, Iterator const end): Store(begin, end)   { }
 
     Junction() = delete;
 
-    ~Junction() { }     // Delete only via subclass, so that we don't need a virtual dtor
+    // Delete only via subclass, so that we don't need a virtual dtor.  It's
+    // trivial, so that a junction over a constexpr store can be constexpr too:
+    ~Junction() = default;
 
     template<typename Subclass, typename Lambda>
     Subclass Map(Lambda const &lambda) const {
         using ResultElement = decltype(lambda(*Store::Elements().begin()));
-        std::set<ResultElement> new_elements;
+        auto new_elements = Details::MakeResultVector<ResultElement> (static_cast<Store const &> (*this));
         for (Element const &elem: Store::Elements())
-            new_elements.insert(lambda(elem));
+            new_elements.push_back(lambda(elem));
 
-        Subclass result(std::move(new_elements));
-        return result;
+        return Details::MakeMapped<Subclass> (static_cast<Store const &> (*this), std::move(new_elements), 0);
     }
 };
 
@@ -101,6 +143,14 @@ class One;
 // Every junction can report its own type:
 enum class JunctionType {None, One, Any, All};
 
+// Pass P6::sorted as the first argument to a junction helper function, as in
+// any(P6::sorted, vec), to promise that the elements are already in ascending
+// order.  The junction can then piggyback on them and still enjoy the
+// optimisations that are normally available only after a copy.  Define
+// P6_CHECK_SORTED to have debug builds assert that the promise is kept.
+struct SortedTag { };
+SortedTag constexpr sorted {};
+
 }
 
 #endif
@@ -0,0 +1,232 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionAllocator_h
+#define      P6JunctionAllocator_h
+
+// Lets junctions that copy their elements take the memory from somewhere other
+// than the global heap.
+//
+// MonotonicArena hands out memory by bumping a pointer through large chunks,
+// and never frees anything until it's released or destroyed, at which point
+// everything goes in one shot.  A request handler can give each request its
+// own arena, build dozens of junctions from it without contending for the
+// global heap's locks, and then throw the lot away.  An arena isn't
+// thread-safe: each thread should have its own.
+//
+// ArenaAllocator is a standard allocator that takes memory from an arena, and
+// so it can be used with any container, as well as with junctions.
+//
+// The helper functions that copy elements -- xxx_copy(), xxx_hash(),
+// xxx_roaring(), xxx_eytzinger(), xxx_packed(), xxx_extremes() and
+// xxx_lazy() -- accept an allocator as their final argument.  This may be a standard
+// allocator of any type, such as an ArenaAllocator, or a MonotonicArena
+// itself, or, with C++17, a pointer to a std::pmr::memory_resource:
+//
+//     P6::MonotonicArena arena;
+//     auto const blocked = any_hash(blocked_ids, arena);
+//     auto const limits  = all_copy(limits_vec, &pmr_resource);
+//
+// Applying a lambda to such a junction builds the result with the same
+// allocator.
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __cplusplus >= 201703L and defined __has_include
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define P6_HAVE_PMR
+#endif
+#endif
+
+namespace P6 {
+
+class MonotonicArena {
+    struct Chunk {
+        Chunk       *next;
+        std::size_t  size;
+    };
+
+    Chunk       *chunks = nullptr;    // The newest, and largest, chunk first
+    char        *cursor = nullptr;
+    char        *limit  = nullptr;
+    std::size_t  next_chunk_size;
+
+    void AddChunk(std::size_t const min_size) {
+        auto const size = std::max(next_chunk_size, min_size + sizeof(Chunk));
+        auto const chunk = static_cast<Chunk *> (::operator new(size));
+        chunk->next = chunks;
+        chunk->size = size;
+        chunks = chunk;
+        cursor = reinterpret_cast<char *> (chunk + 1);
+        limit  = reinterpret_cast<char *> (chunk) + size;
+        next_chunk_size = size * 2;
+    }
+
+public:
+    explicit MonotonicArena(std::size_t const initial_size = 4096)
+        : next_chunk_size(initial_size)   { }
+
+    MonotonicArena(MonotonicArena const &) = delete;
+    MonotonicArena &operator = (MonotonicArena const &) = delete;
+
+    ~MonotonicArena() {
+        while (chunks) {
+            auto const next = chunks->next;
+            ::operator delete(chunks);
+            chunks = next;
+        }
+    }
+
+    void *Allocate(std::size_t const size, std::size_t const alignment) {
+        void *p = cursor;
+        auto space = static_cast<std::size_t> (limit - cursor);
+        if (not chunks or not std::align(alignment, size, p, space)) {
+            AddChunk(size + alignment);
+            p = cursor;
+            space = static_cast<std::size_t> (limit - cursor);
+            std::align(alignment, size, p, space);
+        }
+
+        cursor = static_cast<char *> (p) + size;
+        return p;
+    }
+
+    // Free everything allocated so far, all at once, keeping only the largest
+    // chunk for reuse, so that an arena that's released after each request
+    // soon stops touching the global heap at all:
+    void Release() {
+        if (not chunks)
+            return;
+
+        while (auto const next = chunks->next) {
+            chunks->next = next->next;
+            ::operator delete(next);
+        }
+
+        cursor = reinterpret_cast<char *> (chunks + 1);
+        limit  = reinterpret_cast<char *> (chunks) + chunks->size;
+    }
+};
+
+template<typename T>
+class ArenaAllocator {
+    MonotonicArena *arena;
+
+    template<typename U>
+    friend class ArenaAllocator;
+
+public:
+    using value_type = T;
+
+    ArenaAllocator(MonotonicArena &arena) noexcept
+        : arena(&arena)   { }
+
+    template<typename U>
+    ArenaAllocator(ArenaAllocator<U> const &other) noexcept
+        : arena(other.arena)   { }
+
+    T *allocate(std::size_t const n) {
+        if (n > std::size_t(-1) / sizeof(T))
+            throw std::bad_alloc();
+
+        return static_cast<T *> (arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *, std::size_t) noexcept { }
+
+    template<typename U>
+    bool operator == (ArenaAllocator<U> const &rhs) const noexcept {
+        return arena == rhs.arena;
+    }
+
+    template<typename U>
+    bool operator != (ArenaAllocator<U> const &rhs) const noexcept {
+        return arena != rhs.arena;
+    }
+};
+
+namespace Details {
+
+// Turn whatever the caller passed as an allocator into a standard allocator
+// for elements of type T.  Overload resolution fails for anything else, such
+// as an iterator, so that the helper functions taking allocators don't
+// compete with those taking pairs of iterators.
+
+template<typename T, typename Allocator, typename = decltype(std::declval<Allocator &> ().allocate(std::size_t {1}))>
+typename std::allocator_traits<Allocator>::template rebind_alloc<T> MakeAllocator(Allocator const &allocator) {
+    return typename std::allocator_traits<Allocator>::template rebind_alloc<T> (allocator);
+}
+
+template<typename T>
+ArenaAllocator<T> MakeAllocator(MonotonicArena &arena) {
+    return ArenaAllocator<T> (arena);
+}
+
+#if defined P6_HAVE_PMR
+template<typename T>
+std::pmr::polymorphic_allocator<T> MakeAllocator(std::pmr::memory_resource *const resource) {
+    return std::pmr::polymorphic_allocator<T> (resource);
+}
+#endif
+
+template<typename T, typename Source>
+using AllocatorFor = decltype(MakeAllocator<T>(std::declval<Source &>()));
+
+template<typename Source>
+using EnableIfAllocatorSource = AllocatorFor<char, Source>;
+
+template<typename Allocator, typename T>
+using ReboundAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+// Does a store allocate its elements from somewhere other than the global
+// heap?  If so, it has an Allocator and a GetAllocator() method, and results
+// of applying a lambda come from the same place.
+
+template<typename Store, typename Allocator = typename Store::Allocator>
+std::integral_constant<bool, not std::is_same<Allocator, std::allocator<typename Store::Element>>::value> TestCustomAllocator(int);
+
+template<typename Store>
+std::false_type TestCustomAllocator(...);
+
+template<typename Store>
+struct HasCustomAllocator: decltype(TestCustomAllocator<Store>(0)) { };
+
+template<typename Result, typename Store>
+std::vector<Result> MakeResultVector(Store const &, std::false_type) {
+    return {};
+}
+
+template<typename Result, typename Store>
+std::vector<Result, ReboundAllocator<typename Store::Allocator, Result>> MakeResultVector(Store const &store, std::true_type) {
+    using Allocator = ReboundAllocator<typename Store::Allocator, Result>;
+    return std::vector<Result, Allocator> (Allocator(store.GetAllocator()));
+}
+
+template<typename Result, typename Store>
+auto MakeResultVector(Store const &store) {
+    return MakeResultVector<Result> (store, HasCustomAllocator<Store> ());
+}
+
+} }
+
+#endif
@@ -21,9 +21,32 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 // its members.
 
 #include "Junction.h"
+#include "JunctionAllocator.h"
+#include "JunctionBitsetStore.h"
+#include "JunctionColumnStore.h"
+#include "JunctionConstantStore.h"
+#include "JunctionEnumStore.h"
+#include "JunctionEytzingerStore.h"
+#include "JunctionExtremesStore.h"
+#include "JunctionFlatSortedStore.h"
+#include "JunctionHashStore.h"
+#include "JunctionInternStore.h"
+#include "JunctionIteratorStore.h"
+#include "JunctionLazyStore.h"
+#include "JunctionLookup.h"
+#include "JunctionMappedFileStore.h"
+#include "JunctionOrderedPiggyBackStore.h"
+#include "JunctionPackedStore.h"
 #include "JunctionPiggyBackStore.h"
+#include "JunctionProjectionStore.h"
 #include "JunctionReverseComparisons.h"
+#include "JunctionRoaringStore.h"
+#include "JunctionScan.h"
+#include "JunctionSharedStore.h"
+#include "JunctionSnapshot.h"
 #include "JunctionSortedStore.h"
+#include "JunctionStoreSelection.h"
+#include "JunctionVersionedPiggyBackStore.h"
 
 namespace P6 {
 
@@ -36,12 +59,12 @@ class AnyOrNone: public Junction<Store> {
     using Jct     = Junction<Store>;
     using Element = typename Jct::Element;
 
-    static bool Invert(bool const b) {
+    static bool constexpr Invert(bool const b) {
         return b ^ MustInvert;
     }
 
 public:
-    // True if the junction copied the elements into a new std::set on
+    // True if the junction copied the elements into sorted storage on
     // construction, enabling some optimisations:
     static bool const Ordered = Store::Ordered;
 
@@ -52,8 +75,14 @@ public:
     template<typename Container>
     explicit AnyOrNone(Container const &container):                   Jct(container)   { }
 
-    template<typename Elt>
-    explicit AnyOrNone(std::set<Elt> &&container):                    Jct(std::move(container))   { }
+    template<typename Elt, typename Less, typename Alloc>
+    explicit AnyOrNone(std::set<Elt, Less, Alloc> &&container):       Jct(std::move(container))   { }
+
+    template<typename Elt, typename Alloc>
+    explicit AnyOrNone(std::vector<Elt, Alloc> &&container):          Jct(std::move(container))   { }
+
+    template<typename... Args>
+    constexpr explicit AnyOrNone(Details::InPlaceTag const tag, Args &&...args): Jct(tag, std::forward<Args>(args)...)   { }
 
     template<typename Iterator>
     AnyOrNone(Iterator const begin, Iterator const end):              Jct(begin, end)   { }
@@ -65,7 +94,7 @@ public:
     template<typename Lambda>
     auto operator () (Lambda const &lambda) const {
         using ResultElement = decltype(lambda(Jct::GetAnyElement()));
-        using Result        = AnyOrNone<Details::JunctionSortedStore<ResultElement>, MustInvert>;
+        using Result        = AnyOrNone<typename Details::MappedStore<Store, ResultElement>::type, MustInvert>;
         return Jct::template Map<Result> (lambda);
     }
 
@@ -74,7 +103,7 @@ public:
         return MustInvert? JunctionType::None: JunctionType::All;
     }
 
-    // Because std::set stores elements in ascending order, many of these
+    // Because sorted stores hold elements in ascending order, many of these
     // comparison operators need look at only the first or last element when
     // the backing store is sorted.
     //
@@ -95,18 +124,14 @@ public:
 private:
     template<typename Lambda>
     bool CheckAllElements(Lambda const &lambda) const {
-        for (auto const &elem: Jct::Elements())
-            if (lambda(elem))
-                return true;
-
-        return false;
+        return Details::AnyMatch(Jct::Elements(), lambda);
     }
 
 public:
     // <
 
     template<typename NoneStore>
-    typename Details::EnableIf2<Ordered, bool, NoneStore>::type operator < (None<NoneStore> const &rhs) const {
+    constexpr typename Details::EnableIf2<Ordered, bool, NoneStore>::type operator < (None<NoneStore> const &rhs) const {
         return Invert(not Jct::IsEmpty() and Jct::LastElement() < rhs);
     }
 
@@ -116,7 +141,7 @@ public:
     }
 
     template<typename ElementOrJunction>
-    typename Details::EnableIf2<Ordered, bool, ElementOrJunction>::type operator < (ElementOrJunction const &rhs) const {
+    constexpr typename Details::EnableIf2<Ordered, bool, ElementOrJunction>::type operator < (ElementOrJunction const &rhs) const {
         return Invert(not Jct::IsEmpty() and Jct::FirstElement() < rhs);
     }
 
@@ -128,7 +153,7 @@ public:
     // <=
 
     template<typename NoneStore>
-    typename Details::EnableIf2<Ordered, bool, NoneStore>::type operator <= (None<NoneStore> const &rhs) const {
+    constexpr typename Details::EnableIf2<Ordered, bool, NoneStore>::type operator <= (None<NoneStore> const &rhs) const {
         return Invert(not Jct::IsEmpty() and Jct::LastElement() <= rhs);
     }
 
@@ -138,7 +163,7 @@ public:
     }
 
     template<typename ElementOrJunction>
-    typename Details::EnableIf2<Ordered, bool, ElementOrJunction>::type operator <= (ElementOrJunction const &rhs) const {
+    constexpr typename Details::EnableIf2<Ordered, bool, ElementOrJunction>::type operator <= (ElementOrJunction const &rhs) const {
         return Invert(not Jct::IsEmpty() and Jct::FirstElement() <= rhs);
     }
 
@@ -154,16 +179,30 @@ public:
     // If only one is sorted, we should be able to get it down to O(N lg M),
     // where M is the size of the sorted junction.
 
-    // There's no short-cut when we check for equality or inequality:
+    // An Indexed store can look a single value up instead of scanning for it.
+    // Its elements are distinct, and so at most one of them equals the value,
+    // and at least one differs from it unless it's the only element:
+
+    template<typename ElementOrJunction>
+    constexpr typename Details::EnableIf2<Details::CanLookUp<Store, ElementOrJunction>::value, bool, ElementOrJunction>::type operator == (ElementOrJunction const &rhs) const {
+        return Invert(Jct::Contains(rhs));
+    }
+
+    template<typename ElementOrJunction>
+    constexpr typename Details::EnableIf2<Details::CanLookUp<Store, ElementOrJunction>::value, bool, ElementOrJunction>::type operator != (ElementOrJunction const &rhs) const {
+        return Invert(Jct::GetSize() > (Jct::Contains(rhs)? 1u: 0u));
+    }
+
+    // Otherwise, there's no short-cut when we check for equality or inequality:
     template<typename ElementOrJunction>
-    bool operator == (ElementOrJunction const &rhs) const {
+    typename Details::EnableIf2<not Details::CanLookUp<Store, ElementOrJunction>::value, bool, ElementOrJunction>::type operator == (ElementOrJunction const &rhs) const {
         return Invert(CheckAllElements([&rhs] (Element const &elem) {return elem == rhs;}));
     }
 
     // operator != can't be a straight negation of operator ==, because
     // (any(1, 2) == 2) and (any(1, 2) != 2) are both true.
     template<typename ElementOrJunction>
-    bool operator != (ElementOrJunction const &rhs) const {
+    typename Details::EnableIf2<not Details::CanLookUp<Store, ElementOrJunction>::value, bool, ElementOrJunction>::type operator != (ElementOrJunction const &rhs) const {
         return Invert(CheckAllElements([&rhs] (Element const &elem) {return elem != rhs;}));
     }
 
@@ -173,7 +212,7 @@ public:
     // (any(1, 2) < 2) and (any(1, 2) >= 2) are both true.
 
     template<typename NoneStore>
-    typename Details::EnableIf2<Store::Ordered, bool, NoneStore>::type operator >= (None<NoneStore> const &rhs) const {
+    constexpr typename Details::EnableIf2<Store::Ordered, bool, NoneStore>::type operator >= (None<NoneStore> const &rhs) const {
         return Invert(not Jct::IsEmpty() and Jct::FirstElement() >= rhs);
     }
 
@@ -183,7 +222,7 @@ public:
     }
 
     template<typename ElementOrJunction>
-    typename Details::EnableIf2<Store::Ordered, bool, ElementOrJunction>::type operator >= (ElementOrJunction const &rhs) const {
+    constexpr typename Details::EnableIf2<Store::Ordered, bool, ElementOrJunction>::type operator >= (ElementOrJunction const &rhs) const {
         return Invert(not Jct::IsEmpty() and Jct::LastElement() >= rhs);
     }
 
@@ -197,7 +236,7 @@ public:
     // This can't be a straight negation of operator <=, because
     // (any(1, 2, 3) <= 2) and (any(1, 2, 3) > 2) are both true.
     template<typename NoneStore>
-    typename Details::EnableIf2<Store::Ordered, bool, NoneStore>::type operator > (None<NoneStore> const &rhs) const {
+    constexpr typename Details::EnableIf2<Store::Ordered, bool, NoneStore>::type operator > (None<NoneStore> const &rhs) const {
         return Invert(not Jct::IsEmpty() and Jct::FirstElement() > rhs);
     }
 
@@ -207,7 +246,7 @@ public:
     }
 
     template<typename ElementOrJunction>
-    typename Details::EnableIf2<Store::Ordered, bool, ElementOrJunction>::type operator > (ElementOrJunction const &rhs) const {
+    constexpr typename Details::EnableIf2<Store::Ordered, bool, ElementOrJunction>::type operator > (ElementOrJunction const &rhs) const {
         return Invert(not Jct::IsEmpty() and Jct::LastElement() > rhs);
     }
 
@@ -283,8 +322,10 @@ public:
 //
 // If in doubt, avoid problems by not calling any_ref().
 //
-// Passing a pair of iterators currently causes a copy with no way to override
-// it, but this behaviour will change.
+// A pair of iterators is treated like a named container: any(begin, end) and
+// any_ref(begin, end) refer to the range without copying it, and so the
+// iterators must stay valid for as long as the junction is used, whereas
+// any_copy(begin, end) copies the range into sorted storage.
 //
 // Memory management for one-, one- and all-junctions works in the same way as
 // for any-junctions.
@@ -311,14 +352,14 @@ auto none_ref(std::initializer_list<Element> const &ilist) {
 
 template<typename Element>
 auto any_copy(std::initializer_list<Element> ilist) {
-    using Store = Details::JunctionSortedStore<Element>;
-    return AnyOrNone<Store, false> (ilist);
+    using Store = Details::InitializerListStore<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, false> (ilist.begin(), ilist.end());
 }
 
 template<typename Element>
 auto none_copy(std::initializer_list<Element> const ilist) {
-    using Store = Details::JunctionSortedStore<Element>;
-    return AnyOrNone<Store, true> (ilist);
+    using Store = Details::InitializerListStore<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, true> (ilist.begin(), ilist.end());
 }
 
 // Temporaries get copied by default:
@@ -353,13 +394,13 @@ auto none(std::initializer_list<Element> &ilist) {
 
 template<typename Container>
 auto any_ref(Container const &container) {
-    using Store = Details::JunctionPiggyBackStore<Container>;
+    using Store = Details::PiggyBackStoreFor<Container>;
     return AnyOrNone<Store, false> (container);
 }
 
 template<typename Container>
 auto none_ref(Container const &container) {
-    using Store = Details::JunctionPiggyBackStore<Container>;
+    using Store = Details::PiggyBackStoreFor<Container>;
     return AnyOrNone<Store, true> (container);
 }
 
@@ -368,14 +409,14 @@ auto none_ref(Container const &container) {
 template<typename Container>
 auto any_copy(Container const &container) {
     using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
-    using Store = Details::JunctionSortedStore<Element>;
+    using Store = Details::CopyStoreFor<Details::CopiedElement<Element>>;
     return AnyOrNone<Store, false> (container.begin(), container.end());
 }
 
 template<typename Container>
 auto none_copy(Container const &container) {
     using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
-    using Store = Details::JunctionSortedStore<Element>;
+    using Store = Details::CopyStoreFor<Details::CopiedElement<Element>>;
     return AnyOrNone<Store, true> (container.begin(), container.end());
 }
 
@@ -417,18 +458,46 @@ auto none(Container const &container) {
 // Iterator pairs:
 //
 
-// For now, a pair of iterators causes a copy, although that'll change in time:
+// Force the absence of a copy:
 
 template<typename Iterator>
-auto any(Iterator const begin, Iterator const end) {
+auto any_ref(Iterator const begin, Iterator const end) {
+    using Store = Details::JunctionIteratorStore<Iterator>;
+    return AnyOrNone<Store, false> (begin, end);
+}
+
+template<typename Iterator>
+auto none_ref(Iterator const begin, Iterator const end) {
+    using Store = Details::JunctionIteratorStore<Iterator>;
+    return AnyOrNone<Store, true> (begin, end);
+}
+
+// Force a copy:
+
+template<typename Iterator>
+auto any_copy(Iterator const begin, Iterator const end) {
     using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
-    return AnyOrNone<Details::JunctionSortedStore<Element>, false> (begin, end);
+    using Store = Details::CopyStoreFor<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, false> (begin, end);
 }
 
 template<typename Iterator>
-auto none(Iterator const begin, Iterator const end) {
+auto none_copy(Iterator const begin, Iterator const end) {
     using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
-    return AnyOrNone<Details::JunctionSortedStore<Element>, true> (begin, end);
+    using Store = Details::CopyStoreFor<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, true> (begin, end);
+}
+
+// As with named containers, a pair of iterators doesn't get copied by default:
+
+template<typename Iterator>
+auto any(Iterator const begin, Iterator const end) {
+    return any_ref(begin, end);
+}
+
+template<typename Iterator>
+auto none(Iterator const begin, Iterator const end) {
+    return none_ref(begin, end);
 }
 
 //
@@ -449,8 +518,1300 @@ auto none(std::set<Element> &&elements) {
     return AnyOrNone<Details::JunctionSortedStore<Element>, true> (std::move(elements));
 }
 
-// TODO: assume a named std::set is sorted, too, and piggyback on it, rather
-// than copying it and assuming it's unsorted, which is doubly bad.
+// A named std::set, and any other container for which IsSortedContainer is
+// true, is piggybacked on by JunctionOrderedPiggyBackStore, which can take
+// advantage of its sortedness without copying it.
+
+//
+// Vectors:
+//
+
+// A temporary std::vector of elements that would be copied into a sorted
+// vector is moved into one instead, and sorted and deduplicated in place, so
+// that no memory is allocated.
+
+template<typename Element, typename Alloc, typename Store = Details::AdoptedVectorStore<Element, Alloc>>
+auto any(std::vector<Element, Alloc> &&elements) {
+    return AnyOrNone<Store, false> (std::move(elements));
+}
+
+template<typename Element, typename Alloc, typename Store = Details::AdoptedVectorStore<Element, Alloc>>
+auto none(std::vector<Element, Alloc> &&elements) {
+    return AnyOrNone<Store, true> (std::move(elements));
+}
+
+//
+// Input that the caller promises is sorted:
+//
+
+// Named containers and pairs of iterators are piggybacked on, as usual, but
+// with the optimisations normally reserved for copies:
+
+template<typename Container>
+auto any(SortedTag, Container &container) {
+    Details::CheckSorted(std::begin(container), std::end(container));
+    using Store = Details::JunctionOrderedPiggyBackStore<Container>;
+    return AnyOrNone<Store, false> (container);
+}
+
+template<typename Container>
+auto any(SortedTag, Container const &container) {
+    Details::CheckSorted(std::begin(container), std::end(container));
+    using Store = Details::JunctionOrderedPiggyBackStore<Container>;
+    return AnyOrNone<Store, false> (container);
+}
+
+template<typename Iterator>
+auto any(SortedTag, Iterator const begin, Iterator const end) {
+    Details::CheckSorted(begin, end);
+    using Store = Details::JunctionIteratorStore<Iterator, true>;
+    return AnyOrNone<Store, false> (begin, end);
+}
+
+template<typename Container>
+auto none(SortedTag, Container &container) {
+    Details::CheckSorted(std::begin(container), std::end(container));
+    using Store = Details::JunctionOrderedPiggyBackStore<Container>;
+    return AnyOrNone<Store, true> (container);
+}
+
+template<typename Container>
+auto none(SortedTag, Container const &container) {
+    Details::CheckSorted(std::begin(container), std::end(container));
+    using Store = Details::JunctionOrderedPiggyBackStore<Container>;
+    return AnyOrNone<Store, true> (container);
+}
+
+template<typename Iterator>
+auto none(SortedTag, Iterator const begin, Iterator const end) {
+    Details::CheckSorted(begin, end);
+    using Store = Details::JunctionIteratorStore<Iterator, true>;
+    return AnyOrNone<Store, true> (begin, end);
+}
+
+// A temporary vector is adopted without being sorted again.  Any other
+// temporary container is checked, then copied and sorted as usual:
+
+template<typename Container>
+auto any(SortedTag, Container &&container) {
+    Details::CheckSorted(std::begin(container), std::end(container));
+    return any_copy(container);
+}
+
+template<typename Element, typename Alloc, typename Store = Details::AdoptedVectorStore<Element, Alloc>>
+auto any(SortedTag, std::vector<Element, Alloc> &&elements) {
+    Details::CheckSorted(elements.begin(), elements.end());
+    return AnyOrNone<Store, false> (std::move(elements));
+}
+
+template<typename Container>
+auto none(SortedTag, Container &&container) {
+    Details::CheckSorted(std::begin(container), std::end(container));
+    return none_copy(container);
+}
+
+template<typename Element, typename Alloc, typename Store = Details::AdoptedVectorStore<Element, Alloc>>
+auto none(SortedTag, std::vector<Element, Alloc> &&elements) {
+    Details::CheckSorted(elements.begin(), elements.end());
+    return AnyOrNone<Store, true> (std::move(elements));
+}
+
+//
+// Hashed copies:
+//
+
+// For junctions that are mostly compared for equality with single values, as
+// in (id == any_hash(blocked_ids)), copy the elements into a hash table.  The
+// comparison then takes O(1) expected time; ordering comparisons scan.  As
+// with xxx_copy(), C strings are copied as string_views where possible, so
+// that they're hashed and compared by content rather than by address.
+
+template<typename Element>
+auto any_hash(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionHashStore<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, false> (ilist.begin(), ilist.end());
+}
+
+template<typename Container>
+auto any_hash(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionHashStore<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, false> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto any_hash(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionHashStore<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, false> (begin, end);
+}
+
+template<typename Element>
+auto none_hash(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionHashStore<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, true> (ilist.begin(), ilist.end());
+}
+
+template<typename Container>
+auto none_hash(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionHashStore<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, true> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto none_hash(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionHashStore<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, true> (begin, end);
+}
+
+//
+// Bitsets:
+//
+
+// Copy the elements into a bitset with one bit for each of DomainSize values,
+// starting from zero, so that comparisons with single values take constant
+// time.  Types such as uint8_t get a bitset covering all their values by
+// default when they're copied, and there's no need to specify a DomainSize for
+// them here.
+
+template<std::size_t DomainSize = 0, typename Element>
+auto any_bitset(std::initializer_list<Element> const ilist) {
+    using Store = Details::BitsetStoreFor<Element, DomainSize>;
+    return AnyOrNone<Store, false> (ilist);
+}
+
+template<std::size_t DomainSize = 0, typename Container>
+auto any_bitset(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::BitsetStoreFor<Element, DomainSize>;
+    return AnyOrNone<Store, false> (container.begin(), container.end());
+}
+
+template<std::size_t DomainSize = 0, typename Element>
+auto none_bitset(std::initializer_list<Element> const ilist) {
+    using Store = Details::BitsetStoreFor<Element, DomainSize>;
+    return AnyOrNone<Store, true> (ilist);
+}
+
+template<std::size_t DomainSize = 0, typename Container>
+auto none_bitset(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::BitsetStoreFor<Element, DomainSize>;
+    return AnyOrNone<Store, true> (container.begin(), container.end());
+}
+
+//
+// Compressed bitmaps:
+//
+
+// Copy integers of up to 32 bits into a compressed bitmap, which takes far
+// less memory than a std::set or a sorted vector when there are millions of
+// them, and still gives O(log N) lookups and O(1) ordering comparisons:
+
+template<typename Element>
+auto any_roaring(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionRoaringStore<Element>;
+    return AnyOrNone<Store, false> (ilist);
+}
+
+template<typename Container>
+auto any_roaring(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionRoaringStore<Element>;
+    return AnyOrNone<Store, false> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto any_roaring(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionRoaringStore<Element>;
+    return AnyOrNone<Store, false> (begin, end);
+}
+
+template<typename Element>
+auto none_roaring(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionRoaringStore<Element>;
+    return AnyOrNone<Store, true> (ilist);
+}
+
+template<typename Container>
+auto none_roaring(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionRoaringStore<Element>;
+    return AnyOrNone<Store, true> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto none_roaring(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionRoaringStore<Element>;
+    return AnyOrNone<Store, true> (begin, end);
+}
+
+//
+// Eytzinger layout:
+//
+
+// Copy the elements into an implicit search tree laid out for the cache, for
+// large junctions that are built once and compared with single values many
+// times; see JunctionEytzingerStore.h:
+
+template<typename Element>
+auto any_eytzinger(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionEytzingerStore<Element>;
+    return AnyOrNone<Store, false> (ilist);
+}
+
+template<typename Container>
+auto any_eytzinger(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionEytzingerStore<Element>;
+    return AnyOrNone<Store, false> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto any_eytzinger(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionEytzingerStore<Element>;
+    return AnyOrNone<Store, false> (begin, end);
+}
+
+template<typename Element>
+auto none_eytzinger(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionEytzingerStore<Element>;
+    return AnyOrNone<Store, true> (ilist);
+}
+
+template<typename Container>
+auto none_eytzinger(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionEytzingerStore<Element>;
+    return AnyOrNone<Store, true> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto none_eytzinger(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionEytzingerStore<Element>;
+    return AnyOrNone<Store, true> (begin, end);
+}
+
+//
+// Packed copies:
+//
+
+// Copy integers into sorted, delta-encoded blocks, which take a fraction of
+// the memory of a std::set or a sorted vector when neighbouring elements are
+// close together, as timestamps and sequential ids usually are:
+
+template<typename Element>
+auto any_packed(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionPackedStore<Element>;
+    return AnyOrNone<Store, false> (ilist);
+}
+
+template<typename Container>
+auto any_packed(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionPackedStore<Element>;
+    return AnyOrNone<Store, false> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto any_packed(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionPackedStore<Element>;
+    return AnyOrNone<Store, false> (begin, end);
+}
+
+template<typename Element>
+auto none_packed(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionPackedStore<Element>;
+    return AnyOrNone<Store, true> (ilist);
+}
+
+template<typename Container>
+auto none_packed(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionPackedStore<Element>;
+    return AnyOrNone<Store, true> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto none_packed(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionPackedStore<Element>;
+    return AnyOrNone<Store, true> (begin, end);
+}
+
+//
+// Copies that take memory from an allocator, an arena or, in C++17, a
+// std::pmr::memory_resource -- see JunctionAllocator.h:
+//
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_copy(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionFlatSortedStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_copy(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionFlatSortedStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_copy(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionFlatSortedStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_hash(std::initializer_list<Element> const ilist, Source &&source) {
+    using Copied = Details::CopiedElement<Element>;
+    using Allocator = Details::AllocatorFor<Copied, Source>;
+    using Store = Details::JunctionHashStore<Copied, std::hash<Copied>, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, ilist.begin(), ilist.end(), Details::MakeAllocator<Copied> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_hash(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Copied = Details::CopiedElement<Element>;
+    using Allocator = Details::AllocatorFor<Copied, Source>;
+    using Store = Details::JunctionHashStore<Copied, std::hash<Copied>, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Copied> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_hash(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Copied = Details::CopiedElement<Element>;
+    using Allocator = Details::AllocatorFor<Copied, Source>;
+    using Store = Details::JunctionHashStore<Copied, std::hash<Copied>, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, begin, end, Details::MakeAllocator<Copied> (source));
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_roaring(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionRoaringStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_roaring(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionRoaringStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_roaring(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionRoaringStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_eytzinger(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionEytzingerStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_eytzinger(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionEytzingerStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_eytzinger(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionEytzingerStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_packed(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionPackedStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_packed(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionPackedStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_packed(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionPackedStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_copy(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionFlatSortedStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_copy(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionFlatSortedStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_copy(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionFlatSortedStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_hash(std::initializer_list<Element> const ilist, Source &&source) {
+    using Copied = Details::CopiedElement<Element>;
+    using Allocator = Details::AllocatorFor<Copied, Source>;
+    using Store = Details::JunctionHashStore<Copied, std::hash<Copied>, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, ilist.begin(), ilist.end(), Details::MakeAllocator<Copied> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_hash(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Copied = Details::CopiedElement<Element>;
+    using Allocator = Details::AllocatorFor<Copied, Source>;
+    using Store = Details::JunctionHashStore<Copied, std::hash<Copied>, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Copied> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_hash(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Copied = Details::CopiedElement<Element>;
+    using Allocator = Details::AllocatorFor<Copied, Source>;
+    using Store = Details::JunctionHashStore<Copied, std::hash<Copied>, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, begin, end, Details::MakeAllocator<Copied> (source));
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_roaring(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionRoaringStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_roaring(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionRoaringStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_roaring(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionRoaringStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_eytzinger(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionEytzingerStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_eytzinger(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionEytzingerStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_eytzinger(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionEytzingerStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_packed(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionPackedStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_packed(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionPackedStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_packed(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionPackedStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+//
+// Extremes only:
+//
+
+// Copy the elements without sorting them, finding just the two lowest and two
+// highest in linear time, so that ordering comparisons take constant time and
+// the junction takes O(N) time to build rather than O(N log N).  Equality
+// and inequality scan the elements.  A temporary vector is adopted rather than
+// copied, along with its allocator; otherwise, an allocator may be passed
+// last, as with xxx_copy().
+
+template<typename Element>
+auto any_extremes(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionExtremesStore<Element>;
+    return AnyOrNone<Store, false> (ilist);
+}
+
+template<typename Container>
+auto any_extremes(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionExtremesStore<Element>;
+    return AnyOrNone<Store, false> (container.begin(), container.end());
+}
+
+template<typename Element, typename Alloc>
+auto any_extremes(std::vector<Element, Alloc> &&container) {
+    using Store = Details::JunctionExtremesStore<Element, Alloc>;
+    return AnyOrNone<Store, false> (std::move(container));
+}
+
+template<typename Iterator>
+auto any_extremes(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionExtremesStore<Element>;
+    return AnyOrNone<Store, false> (begin, end);
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_extremes(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionExtremesStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_extremes(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionExtremesStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_extremes(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionExtremesStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Element>
+auto none_extremes(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionExtremesStore<Element>;
+    return AnyOrNone<Store, true> (ilist);
+}
+
+template<typename Container>
+auto none_extremes(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionExtremesStore<Element>;
+    return AnyOrNone<Store, true> (container.begin(), container.end());
+}
+
+template<typename Element, typename Alloc>
+auto none_extremes(std::vector<Element, Alloc> &&container) {
+    using Store = Details::JunctionExtremesStore<Element, Alloc>;
+    return AnyOrNone<Store, true> (std::move(container));
+}
+
+template<typename Iterator>
+auto none_extremes(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionExtremesStore<Element>;
+    return AnyOrNone<Store, true> (begin, end);
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_extremes(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionExtremesStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_extremes(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionExtremesStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_extremes(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionExtremesStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+//
+// Lazily ordered copies:
+//
+
+// Copy the elements without sorting them, and find the lowest and highest
+// only when an ordering comparison first needs them, so that a junction that's
+// only compared for equality never pays for ordering.  As with xxx_extremes(),
+// a temporary vector is adopted, and an allocator may be passed last:
+
+template<typename Element>
+auto any_lazy(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionLazyStore<Element>;
+    return AnyOrNone<Store, false> (ilist);
+}
+
+template<typename Container>
+auto any_lazy(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionLazyStore<Element>;
+    return AnyOrNone<Store, false> (container.begin(), container.end());
+}
+
+template<typename Element, typename Alloc>
+auto any_lazy(std::vector<Element, Alloc> &&container) {
+    using Store = Details::JunctionLazyStore<Element, Alloc>;
+    return AnyOrNone<Store, false> (std::move(container));
+}
+
+template<typename Iterator>
+auto any_lazy(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionLazyStore<Element>;
+    return AnyOrNone<Store, false> (begin, end);
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_lazy(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionLazyStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_lazy(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionLazyStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto any_lazy(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionLazyStore<Element, Allocator>;
+    return AnyOrNone<Store, false> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Element>
+auto none_lazy(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionLazyStore<Element>;
+    return AnyOrNone<Store, true> (ilist);
+}
+
+template<typename Container>
+auto none_lazy(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionLazyStore<Element>;
+    return AnyOrNone<Store, true> (container.begin(), container.end());
+}
+
+template<typename Element, typename Alloc>
+auto none_lazy(std::vector<Element, Alloc> &&container) {
+    using Store = Details::JunctionLazyStore<Element, Alloc>;
+    return AnyOrNone<Store, true> (std::move(container));
+}
+
+template<typename Iterator>
+auto none_lazy(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionLazyStore<Element>;
+    return AnyOrNone<Store, true> (begin, end);
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_lazy(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionLazyStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_lazy(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionLazyStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto none_lazy(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionLazyStore<Element, Allocator>;
+    return AnyOrNone<Store, true> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+//
+// Mutable copies:
+//
+
+// Copy the elements into a std::set, which supports Insert(), Erase() and
+// Assign() in O(log N) time per element while keeping ordering comparisons
+// O(1).  Copies that xxx_copy() makes of containers and iterator ranges,
+// whose elements have too many values for a bitset, are sorted vectors, which
+// support the same methods, but Insert() and Erase() take linear time there.
+// Copies of brace-lists, and of elements such as std::uint8_t, which go into
+// inline arrays and bitsets, support none of them.  As with xxx_copy(), C
+// strings are copied as string_views where possible, so that they compare by
+// content.
+
+template<typename Element>
+auto any_mutable(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionSortedStore<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, false> (ilist.begin(), ilist.end());
+}
+
+template<typename Container>
+auto any_mutable(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionSortedStore<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, false> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto any_mutable(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionSortedStore<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, false> (begin, end);
+}
+
+template<typename Element>
+auto none_mutable(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionSortedStore<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, true> (ilist.begin(), ilist.end());
+}
+
+template<typename Container>
+auto none_mutable(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionSortedStore<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, true> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto none_mutable(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionSortedStore<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, true> (begin, end);
+}
+
+//
+// Versioned containers:
+//
+
+// Piggyback on a container that counts its own mutations -- see
+// JunctionVersionedPiggyBackStore.h -- caching its lowest and highest
+// elements until its version changes:
+
+template<typename Container>
+auto any_versioned(Container const &container) {
+    using Store = Details::JunctionVersionedPiggyBackStore<Container>;
+    return AnyOrNone<Store, false> (container);
+}
+
+template<typename Container>
+auto none_versioned(Container const &container) {
+    using Store = Details::JunctionVersionedPiggyBackStore<Container>;
+    return AnyOrNone<Store, true> (container);
+}
+
+//
+// String views:
+//
+
+// Hold strings as std::string_views, which compare lexicographically with
+// std::strings, std::string_views and C strings alike, without copying the
+// characters.  The views refer to the caller's characters, which must outlive
+// the junction: string literals always do, and a named container of
+// std::strings does as long as it's left alone, but a temporary container
+// doesn't, and so the helpers refuse one.
+
+#if defined P6_HAVE_STRING_VIEW
+inline auto any_sv(std::initializer_list<std::string_view> const ilist) {
+    using Store = Details::InitializerListStore<std::string_view>;
+    return AnyOrNone<Store, false> (ilist.begin(), ilist.end());
+}
+
+template<typename Container>
+auto any_sv(Container const &container) {
+    using Store = Details::CopyStoreFor<std::string_view>;
+    return AnyOrNone<Store, false> (container.begin(), container.end());
+}
+
+template<typename Container>
+auto any_sv(Container const &&container) = delete;
+
+template<typename Iterator>
+auto any_sv(Iterator const begin, Iterator const end) {
+    using Store = Details::CopyStoreFor<std::string_view>;
+    return AnyOrNone<Store, false> (begin, end);
+}
+
+inline auto none_sv(std::initializer_list<std::string_view> const ilist) {
+    using Store = Details::InitializerListStore<std::string_view>;
+    return AnyOrNone<Store, true> (ilist.begin(), ilist.end());
+}
+
+template<typename Container>
+auto none_sv(Container const &container) {
+    using Store = Details::CopyStoreFor<std::string_view>;
+    return AnyOrNone<Store, true> (container.begin(), container.end());
+}
+
+template<typename Container>
+auto none_sv(Container const &&container) = delete;
+
+template<typename Iterator>
+auto none_sv(Iterator const begin, Iterator const end) {
+    using Store = Details::CopyStoreFor<std::string_view>;
+    return AnyOrNone<Store, true> (begin, end);
+}
+#endif
+
+
+//
+// Interned strings:
+//
+
+// Intern the strings in an InternTable -- the process-wide one unless you pass
+// your own as the last argument -- and hold them as 32-bit handles, so that
+// comparing the junction with an InternedString from the same table compares
+// integers.  See JunctionInternTable.h.
+
+template<typename Elem>
+auto any_interned(std::initializer_list<Elem> const ilist, InternTable &table = InternTable::Global()) {
+    using Store = Details::JunctionInternStore;
+    return AnyOrNone<Store, false> (Details::in_place, ilist.begin(), ilist.end(), table);
+}
+
+template<typename Container>
+auto any_interned(Container const &container, InternTable &table = InternTable::Global()) {
+    using Store = Details::JunctionInternStore;
+    return AnyOrNone<Store, false> (Details::in_place, container.begin(), container.end(), table);
+}
+
+template<typename Iterator>
+auto any_interned(Iterator const begin, Iterator const end, InternTable &table = InternTable::Global()) {
+    using Store = Details::JunctionInternStore;
+    return AnyOrNone<Store, false> (Details::in_place, begin, end, table);
+}
+
+template<typename Elem>
+auto none_interned(std::initializer_list<Elem> const ilist, InternTable &table = InternTable::Global()) {
+    using Store = Details::JunctionInternStore;
+    return AnyOrNone<Store, true> (Details::in_place, ilist.begin(), ilist.end(), table);
+}
+
+template<typename Container>
+auto none_interned(Container const &container, InternTable &table = InternTable::Global()) {
+    using Store = Details::JunctionInternStore;
+    return AnyOrNone<Store, true> (Details::in_place, container.begin(), container.end(), table);
+}
+
+template<typename Iterator>
+auto none_interned(Iterator const begin, Iterator const end, InternTable &table = InternTable::Global()) {
+    using Store = Details::JunctionInternStore;
+    return AnyOrNone<Store, true> (Details::in_place, begin, end, table);
+}
+
+
+//
+// Projections:
+//
+
+// Pass a pointer to a data member, a pointer to a member function or a lambda
+// after a container or a pair of iterators to build a junction of the values
+// that it picks out of each element, as in any(orders, &Order::price).  See
+// JunctionProjectionStore.h.  As usual, named containers and pairs of iterators
+// are referred to, so that comparisons read the values in place, while
+// temporary containers and xxx_copy() copy only the projected values.
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto any_ref(Container const &container, Projection const &projection) {
+    using Store = Details::JunctionProjectionStore<decltype(std::begin(container)), Projection>;
+    return AnyOrNone<Store, false> (Details::in_place, std::begin(container), std::end(container), projection);
+}
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto any_copy(Container const &container, Projection const &projection) {
+    using Element = Details::ContainerProjectedElement<Container, Projection>;
+    using Store = Details::CopyStoreFor<Details::CopiedElement<Element>>;
+    auto const begin = Details::MakeProjectingIterator(std::begin(container), projection);
+    auto const end   = Details::MakeProjectingIterator(std::end(container),   projection);
+    return AnyOrNone<Store, false> (begin, end);
+}
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto any(Container &&container, Projection const &projection) {
+    return any_copy(container, projection);
+}
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto any(Container &container, Projection const &projection) {
+    return any_ref(container, projection);
+}
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto any(Container const &container, Projection const &projection) {
+    return any_ref(container, projection);
+}
+
+template<typename Iterator, typename Projection, typename = Details::ProjectedElement<Iterator, Projection>>
+auto any_ref(Iterator const begin, Iterator const end, Projection const &projection) {
+    using Store = Details::JunctionProjectionStore<Iterator, Projection>;
+    return AnyOrNone<Store, false> (Details::in_place, begin, end, projection);
+}
+
+template<typename Iterator, typename Projection, typename = Details::ProjectedElement<Iterator, Projection>>
+auto any_copy(Iterator const begin, Iterator const end, Projection const &projection) {
+    using Element = Details::ProjectedElement<Iterator, Projection>;
+    using Store = Details::CopyStoreFor<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, false> (Details::MakeProjectingIterator(begin, projection), Details::MakeProjectingIterator(end, projection));
+}
+
+template<typename Iterator, typename Projection, typename = Details::ProjectedElement<Iterator, Projection>>
+auto any(Iterator const begin, Iterator const end, Projection const &projection) {
+    return any_ref(begin, end, projection);
+}
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto none_ref(Container const &container, Projection const &projection) {
+    using Store = Details::JunctionProjectionStore<decltype(std::begin(container)), Projection>;
+    return AnyOrNone<Store, true> (Details::in_place, std::begin(container), std::end(container), projection);
+}
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto none_copy(Container const &container, Projection const &projection) {
+    using Element = Details::ContainerProjectedElement<Container, Projection>;
+    using Store = Details::CopyStoreFor<Details::CopiedElement<Element>>;
+    auto const begin = Details::MakeProjectingIterator(std::begin(container), projection);
+    auto const end   = Details::MakeProjectingIterator(std::end(container),   projection);
+    return AnyOrNone<Store, true> (begin, end);
+}
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto none(Container &&container, Projection const &projection) {
+    return none_copy(container, projection);
+}
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto none(Container &container, Projection const &projection) {
+    return none_ref(container, projection);
+}
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto none(Container const &container, Projection const &projection) {
+    return none_ref(container, projection);
+}
+
+template<typename Iterator, typename Projection, typename = Details::ProjectedElement<Iterator, Projection>>
+auto none_ref(Iterator const begin, Iterator const end, Projection const &projection) {
+    using Store = Details::JunctionProjectionStore<Iterator, Projection>;
+    return AnyOrNone<Store, true> (Details::in_place, begin, end, projection);
+}
+
+template<typename Iterator, typename Projection, typename = Details::ProjectedElement<Iterator, Projection>>
+auto none_copy(Iterator const begin, Iterator const end, Projection const &projection) {
+    using Element = Details::ProjectedElement<Iterator, Projection>;
+    using Store = Details::CopyStoreFor<Details::CopiedElement<Element>>;
+    return AnyOrNone<Store, true> (Details::MakeProjectingIterator(begin, projection), Details::MakeProjectingIterator(end, projection));
+}
+
+template<typename Iterator, typename Projection, typename = Details::ProjectedElement<Iterator, Projection>>
+auto none(Iterator const begin, Iterator const end, Projection const &projection) {
+    return none_ref(begin, end, projection);
+}
+
+
+//
+// Columns:
+//
+
+// Refer to a column of a table that's held column-wise -- a pointer, a number
+// of rows and optionally a stride, a P6::Column, or a contiguous container --
+// and scan it in blocks that the compiler can vectorise.  See
+// JunctionColumnStore.h.  Temporary containers are refused, because the
+// junction would outlive them.
+
+template<typename T>
+auto any_column(T const *const data, std::size_t const nr_rows, std::ptrdiff_t const stride = 1) {
+    using Store = Details::JunctionColumnStore<T>;
+    return AnyOrNone<Store, false> (column(data, nr_rows, stride));
+}
+
+template<typename T>
+auto any_column(Column<T> const column) {
+    using Store = Details::JunctionColumnStore<T>;
+    return AnyOrNone<Store, false> (column);
+}
+
+template<typename Contiguous>
+auto any_column(Contiguous const &contiguous) {
+    auto const col = column(contiguous);
+    using Store = Details::JunctionColumnStore<typename decltype(col)::value_type>;
+    return AnyOrNone<Store, false> (col);
+}
+
+template<typename Contiguous>
+auto any_column(Contiguous const &&contiguous) = delete;
+
+template<typename T>
+auto none_column(T const *const data, std::size_t const nr_rows, std::ptrdiff_t const stride = 1) {
+    using Store = Details::JunctionColumnStore<T>;
+    return AnyOrNone<Store, true> (column(data, nr_rows, stride));
+}
+
+template<typename T>
+auto none_column(Column<T> const column) {
+    using Store = Details::JunctionColumnStore<T>;
+    return AnyOrNone<Store, true> (column);
+}
+
+template<typename Contiguous>
+auto none_column(Contiguous const &contiguous) {
+    auto const col = column(contiguous);
+    using Store = Details::JunctionColumnStore<typename decltype(col)::value_type>;
+    return AnyOrNone<Store, true> (col);
+}
+
+template<typename Contiguous>
+auto none_column(Contiguous const &&contiguous) = delete;
+
+// Compare two columns of the same length row by row, returning true if the
+// predicate holds for at least one row -- as in
+// any_rows(bids, asks, std::less<> ()) -- rather than comparing every value
+// in one with every value in the other, as (any_column(bids) < any_column(asks))
+// would.
+
+template<typename Lhs, typename Rhs, typename Predicate>
+bool any_rows(Lhs const &lhs, Rhs const &rhs, Predicate const &predicate) {
+    return Details::ScanRows(column(lhs), column(rhs), predicate, [] (std::size_t const nr_rows, auto const &row_matches) {
+        return Details::AnyRowMatches(nr_rows, row_matches);
+    });
+}
+
+// Likewise, but returning true if the predicate holds for no row:
+
+template<typename Lhs, typename Rhs, typename Predicate>
+bool none_rows(Lhs const &lhs, Rhs const &rhs, Predicate const &predicate) {
+    return not Details::ScanRows(column(lhs), column(rhs), predicate, [] (std::size_t const nr_rows, auto const &row_matches) {
+        return Details::AnyRowMatches(nr_rows, row_matches);
+    });
+}
+
+
+//
+// Memory-mapped files:
+//
+
+// Map a file of fixed-width numbers into memory, read-only, rather than reading
+// it: pass the element type explicitly, as in any_mapped<std::uint64_t>(path),
+// and optionally P6::sorted first if the elements are sorted and unique.  See
+// JunctionMappedFileStore.h.  The hint tells the kernel how the pages will be
+// read.
+
+#if defined P6_HAVE_MMAP
+template<typename Element>
+auto any_mapped(std::string const &path, AccessHint const hint = AccessHint::Sequential) {
+    using Store = Details::JunctionMappedFileStore<Element, false>;
+    return AnyOrNone<Store, false> (Details::in_place, path, hint);
+}
+
+template<typename Element>
+auto any_mapped(SortedTag, std::string const &path, AccessHint const hint = AccessHint::Random) {
+    using Store = Details::JunctionMappedFileStore<Element, true>;
+    return AnyOrNone<Store, false> (Details::in_place, path, hint);
+}
+
+template<typename Element>
+auto none_mapped(std::string const &path, AccessHint const hint = AccessHint::Sequential) {
+    using Store = Details::JunctionMappedFileStore<Element, false>;
+    return AnyOrNone<Store, true> (Details::in_place, path, hint);
+}
+
+template<typename Element>
+auto none_mapped(SortedTag, std::string const &path, AccessHint const hint = AccessHint::Random) {
+    using Store = Details::JunctionMappedFileStore<Element, true>;
+    return AnyOrNone<Store, true> (Details::in_place, path, hint);
+}
+#endif
+
+
+//
+// Snapshots:
+//
+
+// Load a file written by P6::Save() into a sorted copy: pass the element type
+// explicitly, as in any_load<std::uint64_t>(path).  See JunctionSnapshot.h.
+// To use the file without reading it, map it with xxx_mapped() instead.
+
+template<typename Element>
+auto any_load(std::string const &path) {
+    using Store = Details::JunctionFlatSortedStore<Element>;
+    return AnyOrNone<Store, false> (Load<Element> (path));
+}
+
+template<typename Element>
+auto none_load(std::string const &path) {
+    using Store = Details::JunctionFlatSortedStore<Element>;
+    return AnyOrNone<Store, true> (Load<Element> (path));
+}
+
+
+//
+// Constant sets:
+//
+
+// Build a junction of constants at compile time, as in
+// any_constant(2, 3, 5, 7) or any_constant(std::array<int, 4> {...}): its
+// comparisons with single values are constexpr.  See JunctionConstantStore.h.
+
+template<typename T, typename... Ts>
+constexpr auto any_constant(T const first, Ts const ...rest) {
+    using Element = std::common_type_t<T, Ts...>;
+    using Store   = Details::JunctionConstantStore<Element, 1 + sizeof...(Ts)>;
+    return AnyOrNone<Store, false> (Details::in_place, first, rest...);
+}
+
+template<typename T, std::size_t N>
+constexpr auto any_constant(std::array<T, N> const &array) {
+    using Store = Details::JunctionConstantStore<T, N>;
+    return AnyOrNone<Store, false> (Details::in_place, array);
+}
+
+template<typename T, typename... Ts>
+constexpr auto none_constant(T const first, Ts const ...rest) {
+    using Element = std::common_type_t<T, Ts...>;
+    using Store   = Details::JunctionConstantStore<Element, 1 + sizeof...(Ts)>;
+    return AnyOrNone<Store, true> (Details::in_place, first, rest...);
+}
+
+template<typename T, std::size_t N>
+constexpr auto none_constant(std::array<T, N> const &array) {
+    using Store = Details::JunctionConstantStore<T, N>;
+    return AnyOrNone<Store, true> (Details::in_place, array);
+}
+
+
+//
+// Enums:
+//
+
+// Build a junction of enumerators given as template arguments, as in
+// any_enum<State, State::Idle, State::Closed>(), or, with C++17,
+// any_enum<State::Idle, State::Closed>().  Its elements are a bitmask
+// computed at compile time.  See JunctionEnumStore.h.
+
+template<typename E, E... Values>
+constexpr auto any_enum() {
+    using Store = Details::JunctionEnumStore<E, Values...>;
+    return AnyOrNone<Store, false> (Details::in_place);
+}
+
+#if __cplusplus >= 201703L
+template<auto First, decltype(First)... Rest>
+constexpr auto any_enum() {
+    return any_enum<decltype(First), First, Rest...> ();
+}
+#endif
+
+template<typename E, E... Values>
+constexpr auto none_enum() {
+    using Store = Details::JunctionEnumStore<E, Values...>;
+    return AnyOrNone<Store, true> (Details::in_place);
+}
+
+#if __cplusplus >= 201703L
+template<auto First, decltype(First)... Rest>
+constexpr auto none_enum() {
+    return none_enum<decltype(First), First, Rest...> ();
+}
+#endif
+
+
+//
+// Shared memory:
+//
+
+// Attach to the latest generation of elements published under a name by
+// P6::Publish(), as a sorted junction: pass the element type explicitly, as
+// in any_shared<std::uint64_t>("/deny-list").  See JunctionSharedStore.h.
+
+#if defined P6_HAVE_MMAP
+template<typename Element>
+auto any_shared(std::string const &name, AccessHint const hint = AccessHint::Random) {
+    using Store = Details::JunctionSharedStore<Element>;
+    return AnyOrNone<Store, false> (Details::in_place, name, hint);
+}
+
+template<typename Element>
+auto none_shared(std::string const &name, AccessHint const hint = AccessHint::Random) {
+    using Store = Details::JunctionSharedStore<Element>;
+    return AnyOrNone<Store, true> (Details::in_place, name, hint);
+}
+#endif
 
 }
 
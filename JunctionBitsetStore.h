@@ -0,0 +1,341 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionBitsetStore_h
+#define      P6JunctionBitsetStore_h
+
+// Stores a Junction's elements as a bitset, with one bit for each possible
+// value in a small domain, such as the 256 values of a uint8_t or the first
+// 1,024 values of an enum or port number.  Looking up a value is then a single
+// bit test.  The set bits are visited in ascending order, and so the store is
+// Ordered; it finds the two lowest and two highest elements once, when it's
+// built, so that ordering comparisons take constant time.
+//
+// The bits live inside the junction itself, and so building one never
+// allocates; a 256-value domain takes 32 bytes.
+//
+// Types whose every value fits in a small domain, such as char, uint8_t and
+// bool, get a bitset automatically when they're copied.  For anything else,
+// such as an enum, the caller must choose a bitset explicitly, and say how big
+// the domain is; elements then have to lie in [0, DomainSize), and building
+// a bitset from any element outside it throws std::out_of_range.  Applying
+// a lambda to a bitset whose domain starts at zero keeps its integral results
+// in a bitset over the same domain, and so they must lie in it too.
+
+#include "JunctionLookup.h"
+#include "JunctionRange.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace P6 { namespace Details {
+
+// Word-level bit manipulation.  Where the compiler provides intrinsics, they
+// compile to single instructions.  Arguments to CountTrailingZeros() and
+// CountLeadingZeros() must be non-zero.
+
+inline unsigned CountTrailingZeros(std::uint64_t const word) {
+#if defined __GNUC__
+    return static_cast<unsigned> (__builtin_ctzll(word));
+#else
+    unsigned n = 0;
+    for (auto w = word;  (w & 1) == 0;  w >>= 1)
+        ++n;
+
+    return n;
+#endif
+}
+
+inline unsigned CountLeadingZeros(std::uint64_t const word) {
+#if defined __GNUC__
+    return static_cast<unsigned> (__builtin_clzll(word));
+#else
+    unsigned n = 0;
+    for (auto w = word;  (w & (std::uint64_t {1} << 63)) == 0;  w <<= 1)
+        ++n;
+
+    return n;
+#endif
+}
+
+inline unsigned PopCount(std::uint64_t const word) {
+#if defined __GNUC__
+    return static_cast<unsigned> (__builtin_popcountll(word));
+#else
+    unsigned n = 0;
+    for (auto w = word;  w != 0;  w &= w - 1)
+        ++n;
+
+    return n;
+#endif
+}
+
+// Which types have a domain small enough for a bitset to cover every value,
+// and what's the lowest value?
+
+template<typename T, bool IsSmall = std::is_integral<T>::value and sizeof(T) == 1>
+struct SmallDomain {
+    static std::size_t const Size   = 0;
+    static long long const   Lowest = 0;
+};
+
+template<typename T>
+struct SmallDomain<T, true> {
+    static std::size_t const Size   = std::size_t {1} << std::numeric_limits<typename std::make_unsigned<T>::type>::digits;
+    static long long const   Lowest = std::numeric_limits<T>::min();
+};
+
+template<>
+struct SmallDomain<bool, true> {
+    static std::size_t const Size   = 2;
+    static long long const   Lowest = 0;
+};
+
+template<typename T>
+struct HasSmallDomain {
+    static bool const value = SmallDomain<T>::Size != 0;
+};
+
+template<typename T, std::size_t DomainSize = SmallDomain<T>::Size>
+class JunctionBitsetStore {
+public:
+    using Element             = T;
+    static bool const Ordered = true;
+    static bool const Indexed = true;
+
+    static_assert(DomainSize != 0, "Please specify the size of a bitset's domain");
+
+private:
+    using Word = std::uint64_t;
+    static unsigned constexpr BitsPerWord    = 64;
+    static std::size_t constexpr NrWords     = (DomainSize + BitsPerWord - 1) / BitsPerWord;
+
+    // A domain covering every value of a type starts at that type's lowest
+    // value; an explicitly sized domain starts at zero:
+    static long long constexpr Lowest = DomainSize == SmallDomain<T>::Size? SmallDomain<T>::Lowest: 0;
+
+    Word        words[NrWords] {};
+    std::size_t size = 0;
+
+    // The two lowest and two highest elements, for the Ordered comparisons:
+    Element first {}, second {}, penultimate {}, last {};
+
+    // Elements outside the domain would be written past the end of the
+    // bitset, and so they're rejected on every build:
+    static std::size_t IndexOf(Element const elem) {
+        auto const index = static_cast<long long> (elem) - Lowest;
+        if (index < 0 or static_cast<unsigned long long> (index) >= DomainSize)
+            throw std::out_of_range("Element lies outside a bitset's domain");
+
+        return static_cast<std::size_t> (index);
+    }
+
+    static Element ElementAt(std::size_t const index) {
+        return static_cast<Element> (static_cast<long long> (index) + Lowest);
+    }
+
+    bool TestBit(std::size_t const index) const {
+        return (words[index / BitsPerWord] >> (index % BitsPerWord)) & 1;
+    }
+
+    // Find the lowest set bit at or above `index', or return DomainSize if
+    // there isn't one:
+    std::size_t NextSetBit(std::size_t const index) const {
+        if (index >= DomainSize)
+            return DomainSize;
+
+        auto w    = index / BitsPerWord;
+        auto word = words[w] & (~Word {0} << (index % BitsPerWord));
+        while (word == 0) {
+            if (++w == NrWords)
+                return DomainSize;
+
+            word = words[w];
+        }
+
+        return w * BitsPerWord + CountTrailingZeros(word);
+    }
+
+    // Find the highest set bit at or below `index', which must exist:
+    std::size_t PrevSetBit(std::size_t const index) const {
+        auto w    = index / BitsPerWord;
+        auto word = words[w] & (~Word {0} >> (BitsPerWord - 1 - index % BitsPerWord));
+        while (word == 0)
+            word = words[--w];
+
+        return w * BitsPerWord + BitsPerWord - 1 - CountLeadingZeros(word);
+    }
+
+    template<typename Iterator>
+    void Build(Iterator const begin, Iterator const end) {
+        for (auto it = begin;  it != end;  ++it) {
+            auto const index = IndexOf(*it);
+            words[index / BitsPerWord] |= Word {1} << (index % BitsPerWord);
+        }
+
+        for (auto const word: words)
+            size += PopCount(word);
+
+        if (size == 0)
+            return;
+
+        auto const lo = NextSetBit(0);
+        auto const hi = PrevSetBit(DomainSize - 1);
+        first = ElementAt(lo);
+        last  = ElementAt(hi);
+        if (size >= 2) {
+            second      = ElementAt(NextSetBit(lo + 1));
+            penultimate = ElementAt(PrevSetBit(hi - 1));
+        }
+    }
+
+public:
+    // Visits the set bits in ascending order.  Elements are computed from bit
+    // positions, and so the iterator returns them by value.
+    class Iterator {
+        JunctionBitsetStore const *store;
+        std::size_t index;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Element;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Element const *;
+        using reference         = Element;
+
+        Iterator(JunctionBitsetStore const *const store, std::size_t const index)
+            : store(store),
+              index(index)   { }
+
+        Element operator * () const {
+            return ElementAt(index);
+        }
+
+        Iterator &operator ++ () {
+            index = store->NextSetBit(index + 1);
+            return *this;
+        }
+
+        Iterator operator ++ (int) {
+            auto const old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator == (Iterator const &rhs) const {
+            return index == rhs.index;
+        }
+
+        bool operator != (Iterator const &rhs) const {
+            return index != rhs.index;
+        }
+    };
+
+    JunctionBitsetStore(std::initializer_list<Element> const ilist) {
+        Build(ilist.begin(), ilist.end());
+    }
+
+    template<typename It>
+    JunctionBitsetStore(It const begin, It const end) {
+        Build(begin, end);
+    }
+
+    JunctionBitsetStore(std::vector<Element> const &elements) {
+        Build(elements.begin(), elements.end());
+    }
+
+    JunctionRange<Iterator> Elements() const {
+        return {Iterator(this, NextSetBit(0)), Iterator(this, DomainSize)};
+    }
+
+    bool IsEmpty() const {
+        return size == 0;
+    }
+
+    auto GetSize() const {
+        return size;
+    }
+
+    bool HasSecondElement() const {
+        return GetSize() >= 2;
+    }
+
+    // Look up a value of any integral type.  The value can equal an element
+    // only if converting it to Element and back leaves it unchanged, which is
+    // exactly when the usual arithmetic conversions would find it equal to
+    // that element.
+    template<typename Value>
+    bool Contains(Value const &value) const {
+        auto const candidate = static_cast<Element> (value);
+        if (not(candidate == value))
+            return false;
+
+        auto const index = static_cast<long long> (candidate) - Lowest;
+        return index >= 0 and static_cast<std::size_t> (index) < DomainSize and TestBit(static_cast<std::size_t> (index));
+    }
+
+protected:
+    Element const &FirstElement() const {
+        assert(not IsEmpty());
+        return first;
+    }
+
+    Element const &SecondElement() const {
+        assert(HasSecondElement());
+        return second;
+    }
+
+    Element const &PenultimateElement() const {
+        assert(HasSecondElement());
+        return penultimate;
+    }
+
+    Element const &LastElement() const {
+        assert(not IsEmpty());
+        return last;
+    }
+
+    Element const &GetAnyElement() const {
+        return FirstElement();
+    }
+};
+
+// Choose a bitset store for the helper functions, where a DomainSize of zero
+// means "every value of the element type":
+
+template<typename T, std::size_t DomainSize>
+using BitsetStoreFor = JunctionBitsetStore<T, DomainSize == 0? SmallDomain<T>::Size: DomainSize>;
+
+// A bitset can look up any integer, as well as values of its own type:
+
+template<typename T, std::size_t DomainSize, typename Value>
+struct StoreCanLookUp<JunctionBitsetStore<T, DomainSize>, Value> {
+    using V = typename std::decay<Value>::type;
+
+    static bool const value = std::is_same<T, V>::value or
+                              (std::is_integral<T>::value and std::is_integral<V>::value);
+};
+
+} }
+
+#endif
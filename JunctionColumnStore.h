@@ -0,0 +1,339 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionColumnStore_h
+#define      P6JunctionColumnStore_h
+
+// Stores a Junction's elements by reference to a column of a table held
+// column-wise: a pointer to the first value, the number of rows, and,
+// optionally, the distance between neighbouring values, counted in elements,
+// for columns that are interleaved with others.  Nothing is copied, and so
+// the values must outlive the junction.
+//
+// The values aren't sorted, and so comparisons scan them.  Rather than
+// stopping at the first value that decides the answer, the scans test a whole
+// block of values at a time and check the answer between blocks, which lets
+// the compiler turn the tests into vector instructions when they're as simple
+// as comparing numbers.
+//
+// Comparing two column junctions compares every value with every other, as
+// with any other pair of junctions.  To compare two columns row by row
+// instead, as in "every bid is below its ask", use the xxx_rows() helpers,
+// which take the two columns and a predicate; they throw
+// std::invalid_argument if the columns' lengths differ.
+
+#include "JunctionScan.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace P6 {
+
+template<typename T>
+class Column {
+    T const       *data;
+    std::size_t    nr_rows;
+    std::ptrdiff_t stride;
+
+public:
+    using value_type = T;
+
+    class Iterator {
+        T const        *data;
+        std::ptrdiff_t  stride;
+        std::ptrdiff_t  row;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = T const *;
+        using reference         = T const &;
+
+        Iterator(T const *const data, std::ptrdiff_t const stride, std::ptrdiff_t const row)
+            : data(data),
+              stride(stride),
+              row(row)   { }
+
+        T const &operator * () const {
+            return data[row * stride];
+        }
+
+        T const &operator [] (std::ptrdiff_t const n) const {
+            return data[(row + n) * stride];
+        }
+
+        Iterator &operator ++ () {
+            ++row;
+            return *this;
+        }
+
+        Iterator operator ++ (int) {
+            auto const old = *this;
+            ++row;
+            return old;
+        }
+
+        Iterator &operator -- () {
+            --row;
+            return *this;
+        }
+
+        Iterator operator -- (int) {
+            auto const old = *this;
+            --row;
+            return old;
+        }
+
+        Iterator &operator += (std::ptrdiff_t const n) {
+            row += n;
+            return *this;
+        }
+
+        Iterator &operator -= (std::ptrdiff_t const n) {
+            row -= n;
+            return *this;
+        }
+
+        Iterator operator + (std::ptrdiff_t const n) const {
+            return Iterator(data, stride, row + n);
+        }
+
+        Iterator operator - (std::ptrdiff_t const n) const {
+            return Iterator(data, stride, row - n);
+        }
+
+        std::ptrdiff_t operator - (Iterator const &rhs) const {
+            return row - rhs.row;
+        }
+
+        bool operator == (Iterator const &rhs) const {return row == rhs.row;}
+        bool operator != (Iterator const &rhs) const {return row != rhs.row;}
+        bool operator <  (Iterator const &rhs) const {return row <  rhs.row;}
+        bool operator <= (Iterator const &rhs) const {return row <= rhs.row;}
+        bool operator >  (Iterator const &rhs) const {return row >  rhs.row;}
+        bool operator >= (Iterator const &rhs) const {return row >= rhs.row;}
+    };
+
+    using iterator       = Iterator;
+    using const_iterator = Iterator;
+
+    Column(T const *const data, std::size_t const nr_rows, std::ptrdiff_t const stride = 1)
+        : data(data),
+          nr_rows(nr_rows),
+          stride(stride)   { }
+
+    // Refer to the whole of a contiguous container, such as a std::vector or a
+    // std::span:
+    template<typename Contiguous, typename = decltype(std::declval<Contiguous const &> ().data())>
+    Column(Contiguous const &contiguous)
+        : Column(contiguous.data(), contiguous.size())   { }
+
+    T const *GetData() const {
+        return data;
+    }
+
+    std::ptrdiff_t GetStride() const {
+        return stride;
+    }
+
+    Iterator begin() const {
+        return Iterator(data, stride, 0);
+    }
+
+    Iterator end() const {
+        return Iterator(data, stride, static_cast<std::ptrdiff_t> (nr_rows));
+    }
+
+    std::size_t size() const {
+        return nr_rows;
+    }
+
+    bool empty() const {
+        return nr_rows == 0;
+    }
+
+    T const &operator [] (std::size_t const row) const {
+        assert(row < nr_rows);
+        return data[static_cast<std::ptrdiff_t> (row) * stride];
+    }
+};
+
+// Make a Column without naming the element type:
+
+template<typename T>
+Column<T> column(T const *const data, std::size_t const nr_rows, std::ptrdiff_t const stride = 1) {
+    return Column<T> (data, nr_rows, stride);
+}
+
+template<typename Contiguous>
+auto column(Contiguous const &contiguous) {
+    using Element = typename std::remove_const<typename std::remove_pointer<decltype(contiguous.data())>::type>::type;
+    return Column<Element> (contiguous.data(), contiguous.size());
+}
+
+template<typename T>
+Column<T> column(Column<T> const &existing) {
+    return existing;
+}
+
+namespace Details {
+
+// Test this many rows between checks of the answer.  It's enough to fill
+// several vector registers, but few enough that a scan doesn't go far past
+// the row that decides the answer.
+std::size_t constexpr ColumnBlockSize {64};
+
+// Count the rows from `first' onwards, up to `nr_rows' in all, for which
+// row_matches(row) returns true, with no branches that the compiler can't
+// vectorise away:
+template<typename RowMatches>
+std::size_t CountMatchingRows(std::size_t const first, std::size_t const nr_rows, RowMatches const &row_matches) {
+    std::size_t matches {0};
+    for (std::size_t row = first;  row < first + nr_rows;  ++row)
+        matches += row_matches(row)? 1: 0;
+
+    return matches;
+}
+
+template<typename RowMatches>
+bool AllRowsMatch(std::size_t const nr_rows, RowMatches const &row_matches) {
+    for (std::size_t first = 0;  first < nr_rows;  first += ColumnBlockSize) {
+        auto const block_size = std::min(ColumnBlockSize, nr_rows - first);
+        if (CountMatchingRows(first, block_size, row_matches) != block_size)
+            return false;
+    }
+
+    return true;
+}
+
+template<typename RowMatches>
+bool AnyRowMatches(std::size_t const nr_rows, RowMatches const &row_matches) {
+    for (std::size_t first = 0;  first < nr_rows;  first += ColumnBlockSize)
+        if (CountMatchingRows(first, std::min(ColumnBlockSize, nr_rows - first), row_matches) != 0)
+            return true;
+
+    return false;
+}
+
+template<typename RowMatches>
+bool OneRowMatches(std::size_t const nr_rows, RowMatches const &row_matches) {
+    std::size_t matches {0};
+    for (std::size_t first = 0;  first < nr_rows;  first += ColumnBlockSize) {
+        matches += CountMatchingRows(first, std::min(ColumnBlockSize, nr_rows - first), row_matches);
+        if (matches > 1)
+            return false;
+    }
+
+    return matches == 1;
+}
+
+// Apply a row test to each value in a column.  A column of adjacent values
+// gets a loop of its own, because the compiler can't vectorise a load whose
+// stride it doesn't know.
+template<typename T, typename Lambda, typename Scan>
+bool ScanColumn(Column<T> const &column, Lambda const &lambda, Scan const &scan) {
+    auto const data   = column.GetData();
+    auto const stride = column.GetStride();
+    if (stride == 1)
+        return scan(column.size(), [data, &lambda] (std::size_t const row) {return lambda(data[row]);});
+
+    return scan(column.size(), [data, stride, &lambda] (std::size_t const row) {
+        return lambda(data[static_cast<std::ptrdiff_t> (row) * stride]);
+    });
+}
+
+// Likewise, apply a predicate to each row of a pair of columns:
+template<typename T, typename U, typename Predicate, typename Scan>
+bool ScanRows(Column<T> const &lhs, Column<U> const &rhs, Predicate const &predicate, Scan const &scan) {
+    if (lhs.size() != rhs.size())
+        throw std::invalid_argument("Comparing the rows of columns of different lengths");
+
+    if (lhs.GetStride() == 1 and rhs.GetStride() == 1) {
+        auto const lhs_data = lhs.GetData();
+        auto const rhs_data = rhs.GetData();
+        return scan(lhs.size(), [lhs_data, rhs_data, &predicate] (std::size_t const row) {
+            return predicate(lhs_data[row], rhs_data[row]);
+        });
+    }
+
+    return scan(lhs.size(), [&lhs, &rhs, &predicate] (std::size_t const row) {return predicate(lhs[row], rhs[row]);});
+}
+
+// Overload the scans in JunctionScan.h:
+
+template<typename T, typename Lambda>
+bool AllMatch(Column<T> const &column, Lambda const &lambda) {
+    return ScanColumn(column, lambda, [] (std::size_t const nr_rows, auto const &row_matches) {
+        return AllRowsMatch(nr_rows, row_matches);
+    });
+}
+
+template<typename T, typename Lambda>
+bool AnyMatch(Column<T> const &column, Lambda const &lambda) {
+    return ScanColumn(column, lambda, [] (std::size_t const nr_rows, auto const &row_matches) {
+        return AnyRowMatches(nr_rows, row_matches);
+    });
+}
+
+template<typename T, typename Lambda>
+bool OneMatches(Column<T> const &column, Lambda const &lambda) {
+    return ScanColumn(column, lambda, [] (std::size_t const nr_rows, auto const &row_matches) {
+        return OneRowMatches(nr_rows, row_matches);
+    });
+}
+
+template<typename T>
+class JunctionColumnStore {
+public:
+    using Element             = T;
+    static bool const Ordered = false;
+    static bool const Indexed = false;
+
+private:
+    Column<T> column;
+
+protected:
+    JunctionColumnStore(Column<T> const &column)
+        : column(column)   { }
+
+    Element const GetAnyElement() const {
+        assert(not IsEmpty());
+        return column[0];
+    }
+
+public:
+    Column<T> const &Elements() const {
+        return column;
+    }
+
+    bool IsEmpty() const {
+        return column.empty();
+    }
+
+    auto GetSize() const {
+        return column.size();
+    }
+};
+
+} }
+
+#endif
@@ -0,0 +1,185 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionConstantStore_h
+#define      P6JunctionConstantStore_h
+
+// Stores a Junction's elements in an array inside the junction, sorted and
+// deduplicated by a constexpr constructor, so that a junction of constants,
+// such as any_constant(2, 3, 5, 7, 11), can be built at compile time:
+//
+//     constexpr auto primes = any_constant(2, 3, 5, 7, 11);
+//     static_assert(7 == primes, "Seven is prime");
+//
+// Comparing such a junction with a single value takes the same short cuts as
+// a sorted copy, and they're constexpr too, and so they can be used in
+// static_assert.  When the value is known only at run time, the comparison
+// still costs nothing to set up, and it reads the lowest or highest elements,
+// which the compiler knows; a comparison for equality tests a handful of
+// elements one by one, which the compiler can unroll, or, if the elements are
+// consecutive integers, checks that the value lies between the lowest and the
+// highest, or, for larger junctions, uses a binary search.
+//
+// The elements must be of a literal type, such as a number or an enum, and so
+// must the values they're compared with.
+
+#include "JunctionRange.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace P6 { namespace Details {
+
+template<typename T, std::size_t N>
+class JunctionConstantStore {
+public:
+    using Element             = T;
+    static bool const Ordered = true;
+    static bool const Indexed = true;
+
+private:
+    static_assert(std::is_trivially_destructible<T>::value, "Elements of a constant junction must be of a literal type");
+
+    // Up to this many elements are compared one by one:
+    static std::size_t constexpr MaxUnrolled {16};
+
+    T           elements[N == 0? 1: N];
+    std::size_t size;
+    bool        is_range;
+
+    // Sort the elements by insertion, which is as good as anything for the
+    // short lists that are written out in source code, and which a C++14
+    // constexpr constructor can do, and then squeeze out duplicates:
+    constexpr void SortAndDeduplicate() {
+        for (std::size_t i = 1;  i < size;  ++i) {
+            T const elem = elements[i];
+            std::size_t j = i;
+            for (;  j > 0 and elem < elements[j - 1];  --j)
+                elements[j] = elements[j - 1];
+
+            elements[j] = elem;
+        }
+
+        std::size_t nr_unique = size == 0? 0: 1;
+        for (std::size_t i = 1;  i < size;  ++i)
+            if (elements[nr_unique - 1] < elements[i])
+                elements[nr_unique++] = elements[i];
+
+        size = nr_unique;
+    }
+
+    // Consecutive integers need only a range check:
+    constexpr bool IsRange(std::true_type) const {
+        for (std::size_t i = 1;  i < size;  ++i)
+            if (elements[i - 1] + 1 != elements[i])
+                return false;
+
+        return size != 0;
+    }
+
+    constexpr bool IsRange(std::false_type) const {
+        return false;
+    }
+
+public:
+    template<typename... Values>
+    constexpr JunctionConstantStore(Values const ...values)
+        : elements {static_cast<T> (values)...},
+          size(sizeof...(Values)),
+          is_range(false) {
+        static_assert(sizeof...(Values) == N, "Wrong number of elements for a constant junction");
+        SortAndDeduplicate();
+        is_range = IsRange(std::is_integral<T> ());
+    }
+
+    constexpr JunctionConstantStore(std::array<T, N> const &array)
+        : elements {},
+          size(N),
+          is_range(false) {
+        for (std::size_t i = 0;  i < N;  ++i)
+            elements[i] = array[i];
+
+        SortAndDeduplicate();
+        is_range = IsRange(std::is_integral<T> ());
+    }
+
+    JunctionRange<T const *> Elements() const {
+        return {elements, elements + size};
+    }
+
+    constexpr bool IsEmpty() const {
+        return size == 0;
+    }
+
+    constexpr std::size_t GetSize() const {
+        return size;
+    }
+
+    constexpr bool HasSecondElement() const {
+        return size >= 2;
+    }
+
+    constexpr bool Contains(Element const &value) const {
+        if (is_range)
+            return not(value < elements[0]) and not(elements[size - 1] < value);
+
+        if (N <= MaxUnrolled) {
+            for (std::size_t i = 0;  i < size;  ++i)
+                if (elements[i] == value)
+                    return true;
+
+            return false;
+        }
+
+        std::size_t low = 0, high = size;
+        while (low < high) {
+            auto const middle = low + (high - low) / 2;
+            if (elements[middle] < value)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        return low < size and not(value < elements[low]);
+    }
+
+protected:
+    constexpr Element const &FirstElement() const {
+        return assert(not IsEmpty()), elements[0];
+    }
+
+    constexpr Element const &SecondElement() const {
+        return assert(HasSecondElement()), elements[1];
+    }
+
+    constexpr Element const &PenultimateElement() const {
+        return assert(HasSecondElement()), elements[size - 2];
+    }
+
+    constexpr Element const &LastElement() const {
+        return assert(not IsEmpty()), elements[size - 1];
+    }
+
+    constexpr Element const &GetAnyElement() const {
+        return FirstElement();
+    }
+};
+
+} }
+
+#endif
@@ -0,0 +1,180 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionEnumStore_h
+#define      P6JunctionEnumStore_h
+
+// Stores a Junction's elements, a handful of enumerators given as template
+// arguments, as a 64-bit mask computed at compile time, so that a junction
+// such as any_enum<State, State::Idle, State::Closed>() holds no data at all:
+//
+//     if (state == any_enum<State, State::Idle, State::Closed> ())
+//
+// Comparing it with a single value for equality, whether the junction is an
+// Any, None, One or All, tests one bit of the mask: a shift and an AND.
+// Ordering comparisons read the lowest or highest enumerator, which is also
+// known at compile time, and every comparison with a single value is
+// constexpr.
+//
+// With C++17, the enum type can be left out, as in
+// any_enum<State::Idle, State::Closed>().
+//
+// Enumerators must have underlying values in [0, 64).  Plain integral types
+// work too, under the same restriction.
+
+#include "JunctionRange.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace P6 { namespace Details {
+
+// The mask, and the values in order, computed once for each list of values:
+
+template<typename E>
+constexpr long long EnumBitOf(E const value) {
+    return static_cast<long long> (value);
+}
+
+template<typename E, E... Values>
+struct EnumMask {
+    static constexpr bool AllInRange() {
+        E const values[] {Values..., E {}};
+        for (std::size_t i = 0;  i < sizeof...(Values);  ++i)
+            if (EnumBitOf(values[i]) < 0 or EnumBitOf(values[i]) >= 64)
+                return false;
+
+        return true;
+    }
+
+    static_assert(AllInRange(), "Enum junctions need underlying values in [0, 64)");
+
+    static constexpr std::uint64_t MakeMask() {
+        E const values[] {Values..., E {}};
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0;  i < sizeof...(Values);  ++i)
+            mask |= std::uint64_t {1} << EnumBitOf(values[i]);
+
+        return mask;
+    }
+
+    static std::uint64_t constexpr Mask = MakeMask();
+
+    static constexpr std::size_t CountBits() {
+        std::size_t n = 0;
+        for (auto m = Mask;  m != 0;  m &= m - 1)
+            ++n;
+
+        return n;
+    }
+
+    static std::size_t constexpr Size = CountBits();
+
+    // The distinct values in ascending order.  Visiting the bits from the
+    // bottom up sorts them and squeezes out duplicates at the same time.
+    struct Sorted {
+        E elements[Size == 0? 1: Size];
+    };
+
+    static constexpr Sorted MakeSorted() {
+        Sorted sorted {};
+        std::size_t n = 0;
+        for (unsigned bit = 0;  bit < 64;  ++bit)
+            if ((Mask >> bit) & 1)
+                sorted.elements[n++] = static_cast<E> (bit);
+
+        return sorted;
+    }
+
+    static Sorted constexpr sorted = MakeSorted();
+};
+
+// Static constexpr members need definitions before C++17:
+
+template<typename E, E... Values>
+std::uint64_t constexpr EnumMask<E, Values...>::Mask;
+
+template<typename E, E... Values>
+std::size_t constexpr EnumMask<E, Values...>::Size;
+
+template<typename E, E... Values>
+typename EnumMask<E, Values...>::Sorted constexpr EnumMask<E, Values...>::sorted;
+
+template<typename E, E... Values>
+class JunctionEnumStore {
+public:
+    using Element             = E;
+    static bool const Ordered = true;
+    static bool const Indexed = true;
+
+    static_assert(std::is_enum<E>::value or std::is_integral<E>::value, "Enum junctions need an enum or integral type");
+
+private:
+    using Bits = EnumMask<E, Values...>;
+
+public:
+    // One bit for each element, set at bit position equal to its value:
+    static std::uint64_t constexpr GetMask() {
+        return Bits::Mask;
+    }
+
+    JunctionRange<Element const *> Elements() const {
+        return {Bits::sorted.elements, Bits::sorted.elements + Bits::Size};
+    }
+
+    constexpr bool IsEmpty() const {
+        return Bits::Size == 0;
+    }
+
+    constexpr std::size_t GetSize() const {
+        return Bits::Size;
+    }
+
+    constexpr bool HasSecondElement() const {
+        return Bits::Size >= 2;
+    }
+
+    constexpr bool Contains(Element const &value) const {
+        auto const bit = EnumBitOf(value);
+        return bit >= 0 and bit < 64 and ((Bits::Mask >> bit) & 1) != 0;
+    }
+
+protected:
+    constexpr Element const &FirstElement() const {
+        return Bits::sorted.elements[0];
+    }
+
+    constexpr Element const &SecondElement() const {
+        return Bits::sorted.elements[1];
+    }
+
+    constexpr Element const &PenultimateElement() const {
+        return Bits::sorted.elements[Bits::Size - 2];
+    }
+
+    constexpr Element const &LastElement() const {
+        return Bits::sorted.elements[Bits::Size - 1];
+    }
+
+    constexpr Element const &GetAnyElement() const {
+        return FirstElement();
+    }
+};
+
+} }
+
+#endif
@@ -0,0 +1,232 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionExtremesStore_h
+#define      P6JunctionExtremesStore_h
+
+// Stores a copy of a Junction's elements in an unsorted std::vector, alongside
+// the two lowest and two highest distinct elements, which it finds in linear
+// time.  The Ordered comparisons never look at anything else, and so a
+// junction built from this store answers them in constant time, just as a
+// sorted copy would, without paying O(N log N) for the sort.  Equality and
+// inequality scan the vector.
+//
+// The vector keeps any duplicates, and so this store suits All-, Any- and
+// None-junctions, whose answers don't depend on how many times an element
+// appears; One-junctions need distinct elements, and should use a sorted copy
+// instead.
+//
+// The vector can take its memory from any standard allocator; see
+// JunctionAllocator.h.
+
+#include <cassert>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace P6 { namespace Details {
+
+// The two lowest and two highest distinct elements of a container; `second'
+// and `penultimate' are meaningful only if there are at least two distinct
+// elements.
+
+template<typename T>
+struct Extremes {
+    T    first {}, second {}, penultimate {}, last {};
+    bool has_second = false;
+
+    template<typename Container>
+    void Find(Container const &elements) {
+        if (not elements.empty())
+            Find(elements, std::is_integral<T> ());
+    }
+
+    // Alternatively, count duplicates as separate elements, so that `second'
+    // may equal `first', as it would in a sorted container holding both.  This
+    // suits stores that give One-junctions the literal semantic, under which
+    // one({1, 1, 5}) < 3 is false.  It takes a single pass whatever the type.
+    template<typename Container>
+    void FindCountingDuplicates(Container const &elements) {
+        has_second = false;
+        auto it = elements.begin();
+        if (it == elements.end())
+            return;
+
+        first = last = *it;
+        for (++it;  it != elements.end();  ++it) {
+            auto const &elem = *it;
+            if (elem < first) {
+                second = first;
+                first  = elem;
+            }
+            else if (not has_second or elem < second) {
+                second = elem;
+            }
+
+            if (last < elem) {
+                penultimate = last;
+                last        = elem;
+            }
+            else if (not has_second or penultimate < elem) {
+                penultimate = elem;
+            }
+
+            has_second = true;
+        }
+    }
+
+private:
+    // For integers, we make two passes, each of which the compiler can
+    // vectorise, because every step is a branchless min() or max().  The
+    // first pass finds the lowest and highest elements; the second finds the
+    // lowest element above the lowest, and the highest below the highest.
+    template<typename Container>
+    void Find(Container const &elements, std::true_type) {
+        auto lo = *elements.begin(), hi = lo;
+        for (auto const elem: elements) {
+            lo = elem < lo? elem: lo;
+            hi = elem > hi? elem: hi;
+        }
+
+        first = lo;
+        last  = hi;
+        if (lo == hi)
+            return;
+
+        auto above_lo = hi, below_hi = lo;
+        for (auto const elem: elements) {
+            auto const a = elem > lo? elem: hi;
+            auto const b = elem < hi? elem: lo;
+            above_lo = a < above_lo? a: above_lo;
+            below_hi = b > below_hi? b: below_hi;
+        }
+
+        second      = above_lo;
+        penultimate = below_hi;
+        has_second  = true;
+    }
+
+    // Anything else gets a single pass, in which we compare each element with
+    // our four candidates, using only operator<.
+    template<typename Container>
+    void Find(Container const &elements, std::false_type) {
+        auto it = elements.begin();
+        first = last = *it;
+        bool has_penultimate = false;
+
+        for (++it;  it != elements.end();  ++it) {
+            auto const &elem = *it;
+            if (elem < first) {
+                second     = first;
+                first      = elem;
+                has_second = true;
+            }
+            else if (first < elem and (not has_second or elem < second)) {
+                second     = elem;
+                has_second = true;
+            }
+
+            if (last < elem) {
+                penultimate     = last;
+                last            = elem;
+                has_penultimate = true;
+            }
+            else if (elem < last and (not has_penultimate or penultimate < elem)) {
+                penultimate     = elem;
+                has_penultimate = true;
+            }
+        }
+
+        assert(has_second == has_penultimate);
+    }
+};
+
+template<typename T, typename Alloc = std::allocator<T>>
+class JunctionExtremesStore {
+public:
+    using Element             = T;
+    using Allocator           = Alloc;
+    static bool const Ordered = true;
+    static bool const Indexed = false;
+
+private:
+    std::vector<Element, Allocator> elements;
+    Extremes<Element>               extremes;
+
+public:
+    JunctionExtremesStore(std::initializer_list<Element> const ilist, Allocator const &allocator = Allocator())
+        : elements(ilist, allocator) {
+        extremes.Find(elements);
+    }
+
+    template<typename Iterator>
+    JunctionExtremesStore(Iterator const begin, Iterator const end, Allocator const &allocator = Allocator())
+        : elements(begin, end, allocator) {
+        extremes.Find(elements);
+    }
+
+    // Adopt a vector's buffer, and its allocator:
+    JunctionExtremesStore(std::vector<Element, Allocator> &&elements)
+        : elements(std::move(elements)) {
+        extremes.Find(this->elements);
+    }
+
+    std::vector<Element, Allocator> const &Elements() const {
+        return elements;
+    }
+
+    Allocator GetAllocator() const {
+        return elements.get_allocator();
+    }
+
+    bool IsEmpty() const {
+        return elements.empty();
+    }
+
+    bool HasSecondElement() const {
+        return extremes.has_second;
+    }
+
+protected:
+    Element const &FirstElement() const {
+        assert(not IsEmpty());
+        return extremes.first;
+    }
+
+    Element const &SecondElement() const {
+        assert(HasSecondElement());
+        return extremes.second;
+    }
+
+    Element const &PenultimateElement() const {
+        assert(HasSecondElement());
+        return extremes.penultimate;
+    }
+
+    Element const &LastElement() const {
+        assert(not IsEmpty());
+        return extremes.last;
+    }
+
+    Element const &GetAnyElement() const {
+        return FirstElement();
+    }
+};
+
+} }
+
+#endif
@@ -0,0 +1,280 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionEytzingerStore_h
+#define      P6JunctionEytzingerStore_h
+
+// Stores a Junction's elements in Eytzinger order: a sorted, deduplicated set
+// of elements laid out as an implicit binary search tree, in breadth-first
+// order, so that the children of the element at position k live at 2k and
+// 2k + 1.  This is meant for large junctions that are built once and then
+// probed many times.
+//
+// A binary search over a plain sorted vector touches elements that are far
+// apart, and so causes a cache miss at almost every step once the vector
+// outgrows the cache.  In Eytzinger order, the first few levels of the tree
+// share a handful of cache lines, and the 16 descendants four levels below
+// any element are adjacent, so that the search can prefetch them well before
+// it needs them.  The search is also branchless: each step is a comparison
+// and an add, so there's no branch for the processor to mispredict.
+//
+// Elements are visited in ascending order, by an in-order walk of the tree,
+// which takes amortised constant time per element.  The store also finds its
+// two lowest and two highest elements when it's built, and so it's Ordered,
+// and ordering comparisons take constant time.
+//
+// Elements must be default-constructible, because the tree's first slot is
+// left empty to keep the arithmetic simple.
+//
+// The tree can take its memory from any standard allocator; see
+// JunctionAllocator.h.
+
+#include "JunctionBitsetStore.h"
+#include "JunctionRange.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace P6 { namespace Details {
+
+template<typename T, typename Alloc = std::allocator<T>>
+class JunctionEytzingerStore {
+public:
+    using Element             = T;
+    using Allocator           = Alloc;
+    static bool const Ordered = true;
+    static bool const Indexed = true;
+
+private:
+    // tree[0] is unused, so that the root lives at position 1:
+    std::vector<Element, Allocator> tree;
+
+    // The positions of the two lowest and two highest elements, for the
+    // Ordered comparisons; all zero if the store is empty:
+    std::size_t first = 0, second = 0, penultimate = 0, last = 0;
+
+    // Fill the tree from sorted elements with an in-order traversal, and
+    // return the next sorted element to be placed:
+    std::size_t Fill(std::vector<Element, Allocator> &sorted, std::size_t next, std::size_t const k) {
+        if (k < tree.size()) {
+            next = Fill(sorted, next, 2 * k);
+            tree[k] = std::move(sorted[next]);
+            ++next;
+            next = Fill(sorted, next, 2 * k + 1);
+        }
+
+        return next;
+    }
+
+    // The position of the lowest element in the subtree rooted at k:
+    std::size_t Leftmost(std::size_t k) const {
+        while (2 * k < tree.size())
+            k *= 2;
+
+        return k;
+    }
+
+    // The position of the highest element in the subtree rooted at k:
+    std::size_t Rightmost(std::size_t k) const {
+        while (2 * k + 1 < tree.size())
+            k = 2 * k + 1;
+
+        return k;
+    }
+
+    // The in-order successor of position k, or zero if k holds the highest
+    // element:
+    std::size_t Successor(std::size_t k) const {
+        if (2 * k + 1 < tree.size())
+            return Leftmost(2 * k + 1);
+
+        while (k % 2 == 1)
+            k /= 2;
+
+        return k / 2;
+    }
+
+    // The in-order predecessor of position k, which must have one:
+    std::size_t Predecessor(std::size_t k) const {
+        if (2 * k < tree.size())
+            return Rightmost(2 * k);
+
+        while (k % 2 == 0)
+            k /= 2;
+
+        return k / 2;
+    }
+
+    void Build(std::vector<Element, Allocator> &&sorted) {
+        if (not std::is_sorted(sorted.begin(), sorted.end()))
+            std::sort(sorted.begin(), sorted.end());
+
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+        tree.resize(sorted.size() + 1);
+        Fill(sorted, 0, 1);
+        if (IsEmpty())
+            return;
+
+        first = Leftmost(1);
+        last  = Rightmost(1);
+        if (HasSecondElement()) {
+            second      = Successor(first);
+            penultimate = Predecessor(last);
+        }
+    }
+
+public:
+    // Walks the tree in order, and so visits the elements in ascending order;
+    // the end is position zero, which the walk reaches after the highest
+    // element.
+    class Iterator {
+        JunctionEytzingerStore const *store;
+        std::size_t                   k;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Element;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Element const *;
+        using reference         = Element const &;
+
+        Iterator(JunctionEytzingerStore const *const store, std::size_t const k)
+            : store(store),
+              k(k)   { }
+
+        Element const &operator * () const {
+            return store->tree[k];
+        }
+
+        Element const *operator -> () const {
+            return &store->tree[k];
+        }
+
+        Iterator &operator ++ () {
+            k = store->Successor(k);
+            return *this;
+        }
+
+        Iterator operator ++ (int) {
+            auto const old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator == (Iterator const &rhs) const {
+            return k == rhs.k;
+        }
+
+        bool operator != (Iterator const &rhs) const {
+            return k != rhs.k;
+        }
+    };
+
+    JunctionEytzingerStore(std::initializer_list<Element> const ilist, Allocator const &allocator = Allocator())
+        : tree(allocator) {
+        Build(std::vector<Element, Allocator> (ilist, allocator));
+    }
+
+    template<typename Iterator>
+    JunctionEytzingerStore(Iterator const begin, Iterator const end, Allocator const &allocator = Allocator())
+        : tree(allocator) {
+        Build(std::vector<Element, Allocator> (begin, end, allocator));
+    }
+
+    JunctionEytzingerStore(std::vector<Element, Allocator> &&elements)
+        : tree(elements.get_allocator()) {
+        Build(std::move(elements));
+    }
+
+    JunctionRange<Iterator> Elements() const {
+        return {Iterator(this, first), Iterator(this, 0)};
+    }
+
+    Allocator GetAllocator() const {
+        return tree.get_allocator();
+    }
+
+    bool IsEmpty() const {
+        return tree.size() <= 1;
+    }
+
+    auto GetSize() const {
+        return tree.size() - 1;
+    }
+
+    bool HasSecondElement() const {
+        return GetSize() >= 2;
+    }
+
+    // Descend from the root, going right whenever the current element is less
+    // than the value.  We finish in a leaf's missing child; the bits of its
+    // position record the turns we took, and the last left turn, undone by
+    // stripping the trailing ones and then one more bit, leads to the lowest
+    // element not less than the value.
+    bool Contains(Element const &value) const {
+        auto const n = tree.size();
+        auto const data = tree.data();
+        std::size_t k = 1;
+        while (k < n) {
+#if defined __GNUC__
+            // Fetch the cache line holding this element's descendants four
+            // levels down:
+            __builtin_prefetch(data + (16 * k < n? 16 * k: 0));
+#endif
+            k = 2 * k + (data[k] < value);
+        }
+
+        k >>= CountTrailingZeros(~static_cast<std::uint64_t> (k)) + 1;
+        return k != 0 and not(value < data[k]);
+    }
+
+protected:
+    Element const &FirstElement() const {
+        assert(not IsEmpty());
+        return tree[first];
+    }
+
+    Element const &SecondElement() const {
+        assert(HasSecondElement());
+        return tree[second];
+    }
+
+    Element const &PenultimateElement() const {
+        assert(HasSecondElement());
+        return tree[penultimate];
+    }
+
+    Element const &LastElement() const {
+        assert(not IsEmpty());
+        return tree[last];
+    }
+
+    Element const &GetAnyElement() const {
+        return FirstElement();
+    }
+
+};
+
+} }
+
+#endif
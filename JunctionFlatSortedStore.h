@@ -0,0 +1,175 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionFlatSortedStore_h
+#define      P6JunctionFlatSortedStore_h
+
+// Stores a Junction's elements in a sorted, deduplicated std::vector.  Like
+// JunctionSortedStore, it holds them in ascending order, enabling the same
+// optimisations for some comparisons; unlike JunctionSortedStore, it makes a
+// single allocation rather than one per element, and it keeps the elements
+// contiguous, so that scans and neighbouring elements are cache-friendly.
+//
+// The vector can take its memory from any standard allocator; see
+// JunctionAllocator.h.
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace P6 { namespace Details {
+
+template<typename T, typename Alloc = std::allocator<T>>
+class JunctionFlatSortedStore {
+public:
+    using Element             = T;
+    using Allocator           = Alloc;
+    static bool const Ordered = true;
+    static bool const Indexed = true;
+
+private:
+    std::vector<Element, Allocator> elements;
+
+    // Establish our invariant in O(N log N) time: one sort, and then a single
+    // pass to squeeze out duplicates, as std::set would have done for us.  If
+    // we're copying a container that's already sorted, such as a std::set,
+    // the sort is skipped; unsorted input is usually detected within the first
+    // few elements.
+    void SortAndDeduplicate() {
+        if (not std::is_sorted(elements.begin(), elements.end()))
+            std::sort(elements.begin(), elements.end());
+
+        elements.erase(std::unique(elements.begin(), elements.end()), elements.end());
+    }
+
+public:
+    JunctionFlatSortedStore(std::initializer_list<Element> const ilist)
+        : elements(ilist) {
+        SortAndDeduplicate();
+    }
+
+    template<typename Iterator>
+    JunctionFlatSortedStore(Iterator const begin, Iterator const end)
+        : elements(begin, end) {
+        SortAndDeduplicate();
+    }
+
+    JunctionFlatSortedStore(std::initializer_list<Element> const ilist, Allocator const &allocator)
+        : elements(ilist, allocator) {
+        SortAndDeduplicate();
+    }
+
+    template<typename Iterator>
+    JunctionFlatSortedStore(Iterator const begin, Iterator const end, Allocator const &allocator)
+        : elements(begin, end, allocator) {
+        SortAndDeduplicate();
+    }
+
+    // Adopt a vector's buffer and sort it in place:
+    JunctionFlatSortedStore(std::vector<Element, Allocator> &&elements)
+        : elements(std::move(elements)) {
+        SortAndDeduplicate();
+    }
+
+    std::vector<Element, Allocator> const &Elements() const {
+        return elements;
+    }
+
+    Allocator GetAllocator() const {
+        return elements.get_allocator();
+    }
+
+    // Add a value, keeping the elements sorted and unique, and return true if
+    // it wasn't already present.  Finding the place takes O(log N) time, but
+    // making room for the value means moving every later element.
+    bool Insert(Element const &value) {
+        auto const it = std::lower_bound(elements.begin(), elements.end(), value);
+        if (it != elements.end() and not(value < *it))
+            return false;
+
+        elements.insert(it, value);
+        return true;
+    }
+
+    // Remove a value, returning true if it was present:
+    bool Erase(Element const &value) {
+        auto const it = std::lower_bound(elements.begin(), elements.end(), value);
+        if (it == elements.end() or value < *it)
+            return false;
+
+        elements.erase(it);
+        return true;
+    }
+
+    // Replace all the elements at once:
+    void Assign(std::initializer_list<Element> const ilist) {
+        elements.assign(ilist);
+        SortAndDeduplicate();
+    }
+
+    template<typename Iterator>
+    void Assign(Iterator const begin, Iterator const end) {
+        elements.assign(begin, end);
+        SortAndDeduplicate();
+    }
+
+    bool IsEmpty() const {
+        return elements.empty();
+    }
+
+    auto GetSize() const {
+        return elements.size();
+    }
+
+    bool HasSecondElement() const {
+        return GetSize() >= 2;
+    }
+
+    bool Contains(Element const &value) const {
+        return std::binary_search(elements.begin(), elements.end(), value);
+    }
+
+protected:
+    Element const &FirstElement() const {
+        assert(not IsEmpty());
+        return elements.front();
+    }
+
+    Element const &SecondElement() const {
+        assert(HasSecondElement());
+        return elements[1];
+    }
+
+    Element const &PenultimateElement() const {
+        assert(HasSecondElement());
+        return elements[elements.size() - 2];
+    }
+
+    Element const &LastElement() const {
+        assert(not IsEmpty());
+        return elements.back();
+    }
+
+    Element const &GetAnyElement() const {
+        return FirstElement();
+    }
+};
+
+} }
+
+#endif
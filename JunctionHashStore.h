@@ -0,0 +1,177 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionHashStore_h
+#define      P6JunctionHashStore_h
+
+// Stores a Junction's elements in a std::vector, deduplicated but in no
+// particular order, alongside an open-addressing hash table that indexes the
+// vector.  Comparing the junction with a single value for equality or
+// inequality then takes O(1) expected time instead of a scan, which suits
+// junctions used for allow-lists and deny-lists, as in
+// (id == any_hash(blocked_ids)).
+//
+// The elements aren't sorted, and so ordering comparisons fall back to
+// scanning the vector, which is as quick as scanning any other contiguous
+// container.
+//
+// Both the vector and the table can take their memory from any standard
+// allocator; see JunctionAllocator.h.  The table's slots are 32 bits wide,
+// and so building a store from 2^31 or more elements throws
+// std::length_error.
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace P6 { namespace Details {
+
+template<typename T, typename Hash = std::hash<T>, typename Alloc = std::allocator<T>>
+class JunctionHashStore {
+public:
+    using Element             = T;
+    using Allocator           = Alloc;
+    static bool const Ordered = false;
+    static bool const Indexed = true;
+
+private:
+    // Each slot holds zero if it's empty, or one more than the index of an
+    // element in `elements'.  We keep the table at most half full, so that
+    // linear probing stays short.
+    using Slot = std::uint32_t;
+
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+
+    std::vector<Element, Allocator>  elements;
+    std::vector<Slot, SlotAllocator> slots;
+    unsigned             shift = 0;
+
+    // std::hash is the identity function for integers on common platforms,
+    // and ids that are multiples of a power of two would then pile up in a
+    // few slots.  Fibonacci hashing spreads them out by taking the top bits of
+    // the product of the hash and 2^64 divided by the golden ratio.
+    std::size_t SlotFor(Element const &elem) const {
+        std::uint64_t const hash = Hash()(elem);
+        return static_cast<std::size_t> ((hash * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    std::size_t NextSlot(std::size_t const slot) const {
+        return (slot + 1) & (slots.size() - 1);
+    }
+
+    // Returns the slot that holds an equal element, or the empty slot where
+    // one would go:
+    std::size_t Probe(Element const &elem) const {
+        auto slot = SlotFor(elem);
+        while (slots[slot] != 0 and not(elements[slots[slot] - 1] == elem))
+            slot = NextSlot(slot);
+
+        return slot;
+    }
+
+    // Copy the candidates in a single pass, so that input iterators will do,
+    // and then squeeze out duplicates in place while filling the table:
+    template<typename Iterator>
+    void Build(Iterator const begin, Iterator const end) {
+        elements.assign(begin, end);
+        auto const nr_candidates = elements.size();
+        if (nr_candidates == 0)
+            return;
+
+        if (nr_candidates >= (std::size_t {1} << 31))
+            throw std::length_error("A hash store holds fewer than 2^31 elements");
+
+        unsigned log_capacity = 1;
+        while ((std::size_t {1} << log_capacity) < 2 * nr_candidates)
+            ++log_capacity;
+
+        shift = 64 - log_capacity;
+        slots.assign(std::size_t {1} << log_capacity, 0);
+
+        std::size_t nr_kept = 0;
+        for (std::size_t i = 0;  i != nr_candidates;  ++i) {
+            auto const slot = Probe(elements[i]);
+            if (slots[slot] == 0) {
+                if (i != nr_kept)
+                    elements[nr_kept] = std::move(elements[i]);
+
+                slots[slot] = static_cast<Slot> (++nr_kept);
+            }
+        }
+
+        elements.erase(elements.begin() + static_cast<std::ptrdiff_t> (nr_kept), elements.end());
+        elements.shrink_to_fit();
+    }
+
+public:
+    JunctionHashStore(std::initializer_list<Element> const ilist) {
+        Build(ilist.begin(), ilist.end());
+    }
+
+    template<typename Iterator>
+    JunctionHashStore(Iterator const begin, Iterator const end) {
+        Build(begin, end);
+    }
+
+    JunctionHashStore(std::initializer_list<Element> const ilist, Allocator const &allocator)
+        : elements(allocator),
+          slots(SlotAllocator(allocator)) {
+        Build(ilist.begin(), ilist.end());
+    }
+
+    template<typename Iterator>
+    JunctionHashStore(Iterator const begin, Iterator const end, Allocator const &allocator)
+        : elements(allocator),
+          slots(SlotAllocator(allocator)) {
+        Build(begin, end);
+    }
+
+    std::vector<Element, Allocator> const &Elements() const {
+        return elements;
+    }
+
+    Allocator GetAllocator() const {
+        return elements.get_allocator();
+    }
+
+    bool IsEmpty() const {
+        return elements.empty();
+    }
+
+    auto GetSize() const {
+        return elements.size();
+    }
+
+    bool Contains(Element const &value) const {
+        return not IsEmpty() and slots[Probe(value)] != 0;
+    }
+
+protected:
+    Element const &GetAnyElement() const {
+        assert(not IsEmpty());
+        return elements.front();
+    }
+};
+
+} }
+
+#endif
@@ -0,0 +1,174 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionInlineStore_h
+#define      P6JunctionInlineStore_h
+
+// Stores a Junction's elements in a small buffer inside the junction itself,
+// so that copying a short brace-list, as in all({x, y, z}), needn't touch the
+// heap.  The elements are put in order with a sorting network and then
+// deduplicated, and so the same optimisations apply as for
+// JunctionFlatSortedStore.  If we're ever given more elements than will fit,
+// they spill into a std::vector, which otherwise stays empty and unallocated.
+
+#include "JunctionRange.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace P6 { namespace Details {
+
+// Swap two elements if they're out of order, using only operator <.  For
+// scalars, the compiler turns this into a pair of conditional moves.
+
+template<typename Element>
+inline void CompareExchange(Element &a, Element &b) {
+    Element const lo = b < a? b: a;
+    Element const hi = b < a? a: b;
+    a = lo;
+    b = hi;
+}
+
+// Sort up to eight elements with an optimal sorting network, and anything
+// larger with std::sort.  The comparators for each size are stored one after
+// another; NetworkStart[n] indexes the first comparator for n elements, and
+// NetworkStart[n + 1] indexes the one after its last.
+
+template<typename Element>
+void SortSmall(Element *const data, std::size_t const size) {
+    static unsigned char const Network[][2] {
+        {0, 1},
+        {0, 1}, {1, 2}, {0, 1},
+        {0, 1}, {2, 3}, {0, 2}, {1, 3}, {1, 2},
+        {0, 1}, {3, 4}, {2, 4}, {2, 3}, {1, 4}, {0, 3}, {0, 2}, {1, 3}, {1, 2},
+        {1, 2}, {4, 5}, {0, 2}, {3, 5}, {0, 1}, {3, 4}, {1, 4}, {0, 3}, {2, 5}, {1, 3}, {2, 4}, {2, 3},
+        {1, 2}, {3, 4}, {5, 6}, {0, 2}, {3, 5}, {4, 6}, {0, 1}, {4, 5}, {2, 6}, {0, 4}, {1, 5}, {0, 3}, {2, 5}, {1, 3}, {2, 4}, {2, 3},
+        {0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}, {0, 1}, {2, 3}, {4, 5}, {6, 7}, {2, 4}, {3, 5}, {1, 4}, {3, 6}, {1, 2}, {3, 4}, {5, 6},
+    };
+
+    static unsigned char const NetworkStart[] {0, 0, 0, 1, 4, 9, 18, 30, 46, 65};
+    static std::size_t constexpr MaxNetworkSize = sizeof NetworkStart / sizeof *NetworkStart - 2;
+
+    if (size > MaxNetworkSize) {
+        std::sort(data, data + size);
+        return;
+    }
+
+    for (auto i = NetworkStart[size];  i != NetworkStart[size + 1];  ++i)
+        CompareExchange(data[Network[i][0]], data[Network[i][1]]);
+}
+
+template<typename T, std::size_t Capacity = 8>
+class JunctionInlineStore {
+public:
+    using Element             = T;
+    static bool const Ordered = true;
+    static bool const Indexed = true;
+
+    static_assert(std::is_trivially_copyable<Element>::value, "JunctionInlineStore is only for trivially copyable elements");
+
+private:
+    Element inline_elements[Capacity] {};
+    std::vector<Element> spilled;
+    std::size_t size;
+
+    Element *Data() {
+        return spilled.empty()? inline_elements: spilled.data();
+    }
+
+    Element const *Data() const {
+        return spilled.empty()? inline_elements: spilled.data();
+    }
+
+    template<typename Iterator>
+    void Assign(Iterator const begin, Iterator const end) {
+        size = static_cast<std::size_t> (std::distance(begin, end));
+        if (size <= Capacity) {
+            std::copy(begin, end, inline_elements);
+            SortSmall(inline_elements, size);
+        }
+        else {
+            spilled.assign(begin, end);
+            std::sort(spilled.begin(), spilled.end());
+        }
+
+        size = static_cast<std::size_t> (std::unique(Data(), Data() + size) - Data());
+    }
+
+public:
+    JunctionInlineStore(std::initializer_list<Element> const ilist) {
+        Assign(ilist.begin(), ilist.end());
+    }
+
+    template<typename Iterator>
+    JunctionInlineStore(Iterator const begin, Iterator const end) {
+        Assign(begin, end);
+    }
+
+    JunctionRange<Element const *> Elements() const {
+        return {Data(), Data() + size};
+    }
+
+    bool IsEmpty() const {
+        return size == 0;
+    }
+
+    auto GetSize() const {
+        return size;
+    }
+
+    bool HasSecondElement() const {
+        return GetSize() >= 2;
+    }
+
+    bool Contains(Element const &value) const {
+        return std::binary_search(Data(), Data() + size, value);
+    }
+
+protected:
+    Element const &FirstElement() const {
+        assert(not IsEmpty());
+        return Data()[0];
+    }
+
+    Element const &SecondElement() const {
+        assert(HasSecondElement());
+        return Data()[1];
+    }
+
+    Element const &PenultimateElement() const {
+        assert(HasSecondElement());
+        return Data()[size - 2];
+    }
+
+    Element const &LastElement() const {
+        assert(not IsEmpty());
+        return Data()[size - 1];
+    }
+
+    Element const &GetAnyElement() const {
+        return FirstElement();
+    }
+};
+
+} }
+
+#endif
@@ -0,0 +1,221 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionInternStore_h
+#define      P6JunctionInternStore_h
+
+// Stores a Junction's strings as 32-bit handles into an InternTable, in a
+// JunctionHashStore.  Interning costs a hash lookup per string when the
+// junction is built; after that, comparing the junction with an InternedString
+// from the same table compares integers rather than characters, and the
+// handles take four bytes each, however long the strings are.
+//
+// Comparing the junction with a std::string or a C string looks the string up
+// in the table once, where it lies, without interning or copying it, and then
+// compares handles.
+// Ordering comparisons, which need the characters, scan the elements.
+//
+// Applying a lambda that returns strings interns the results in the same
+// table.
+
+#include "JunctionHashStore.h"
+#include "JunctionInternTable.h"
+#include "JunctionLookup.h"
+#include "JunctionRange.h"
+#include "JunctionStoreSelection.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace P6 { namespace Details {
+
+class JunctionInternStore {
+public:
+    using Element             = InternedString;
+    static bool const Ordered = false;
+    static bool const Indexed = true;
+
+private:
+    using Handles = JunctionHashStore<std::uint32_t>;
+
+    InternTable *table;
+    Handles      handles;
+
+    static std::uint32_t Intern(InternTable &table, InternedString const &str) {
+        return &str.GetTable() == &table? str.GetHandle(): table.Intern(str.Str()).GetHandle();
+    }
+
+    static std::uint32_t Intern(InternTable &table, std::string const &str) {
+        return table.Intern(str).GetHandle();
+    }
+
+    template<typename String>
+    static std::uint32_t Intern(InternTable &table, String const &str) {
+        return table.Intern(std::string(str)).GetHandle();
+    }
+
+    template<typename Iterator>
+    static Handles InternAll(InternTable &table, Iterator const begin, Iterator const end) {
+        std::vector<std::uint32_t> result;
+        for (auto it = begin;  it != end;  ++it)
+            result.push_back(Intern(table, *it));
+
+        return Handles(result.begin(), result.end());
+    }
+
+public:
+    // Turns handles back into InternedStrings, and so returns them by value:
+    class Iterator {
+        InternTable const                                 *table;
+        std::vector<std::uint32_t>::const_iterator         it;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Element;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Element const *;
+        using reference         = Element;
+
+        Iterator(InternTable const *const table, std::vector<std::uint32_t>::const_iterator const it)
+            : table(table),
+              it(it)   { }
+
+        Element operator * () const {
+            return Element(*table, *it);
+        }
+
+        Iterator &operator ++ () {
+            ++it;
+            return *this;
+        }
+
+        Iterator operator ++ (int) {
+            auto const old = *this;
+            ++it;
+            return old;
+        }
+
+        bool operator == (Iterator const &rhs) const {
+            return it == rhs.it;
+        }
+
+        bool operator != (Iterator const &rhs) const {
+            return it != rhs.it;
+        }
+    };
+
+    template<typename Elem>
+    JunctionInternStore(std::initializer_list<Elem> const ilist, InternTable &table = InternTable::Global())
+        : table(&table),
+          handles(InternAll(table, ilist.begin(), ilist.end()))   { }
+
+    template<typename It>
+    JunctionInternStore(It const begin, It const end, InternTable &table = InternTable::Global())
+        : table(&table),
+          handles(InternAll(table, begin, end))   { }
+
+    template<typename Elem, typename Alloc>
+    JunctionInternStore(std::vector<Elem, Alloc> &&elements, InternTable &table = InternTable::Global())
+        : table(&table),
+          handles(InternAll(table, elements.begin(), elements.end()))   { }
+
+    JunctionRange<Iterator> Elements() const {
+        auto const &all = handles.Elements();
+        return {Iterator(table, all.begin()), Iterator(table, all.end())};
+    }
+
+    bool IsEmpty() const {
+        return handles.IsEmpty();
+    }
+
+    auto GetSize() const {
+        return handles.GetSize();
+    }
+
+    // An InternedString from our own table needs no lookup in it:
+    bool Contains(InternedString const &value) const {
+        if (&value.GetTable() == table)
+            return handles.Contains(value.GetHandle());
+
+        return Contains(value.Str());
+    }
+
+    // Strings are looked up where they lie, without copying them:
+    bool Contains(std::string const &value) const {
+        std::uint32_t handle;
+        return table->Find(value, handle) and handles.Contains(handle);
+    }
+
+    bool Contains(char const *const value) const {
+        std::uint32_t handle;
+        return table->Find(value, handle) and handles.Contains(handle);
+    }
+
+#if __cplusplus >= 201703L
+    bool Contains(std::string_view const value) const {
+        std::uint32_t handle;
+        return table->Find(value, handle) and handles.Contains(handle);
+    }
+#endif
+
+    // Anything else that converts to a string is converted once:
+    template<typename String>
+    bool Contains(String const &value) const {
+        return Contains(std::string(value));
+    }
+
+    // Junctions made by applying a lambda to this one intern their strings in
+    // the same table:
+    InternTable &MappedContext() const {
+        return *table;
+    }
+
+protected:
+    Element GetAnyElement() const {
+        assert(not IsEmpty());
+        return *Elements().begin();
+    }
+};
+
+// We can look up InternedStrings and anything that compares with them:
+
+template<typename Value>
+struct StoreCanLookUp<JunctionInternStore, Value> {
+    using V = typename std::decay<Value>::type;
+
+    static bool const value = std::is_same<V, InternedString>::value or IsStringLike<V>::value;
+};
+
+// Applying a lambda that returns strings keeps them interned:
+
+template<typename ResultElement>
+struct MappedStore<JunctionInternStore, ResultElement, false> {
+    using type = typename std::conditional<
+        std::is_same<ResultElement, std::string>::value or std::is_same<ResultElement, InternedString>::value,
+        JunctionInternStore,
+        CopyStoreFor<ResultElement>
+    >::type;
+};
+
+} }
+
+#endif
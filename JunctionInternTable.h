@@ -0,0 +1,286 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionInternTable_h
+#define      P6JunctionInternTable_h
+
+// Interns strings, so that two equal strings get the same 32-bit handle and
+// comparing them for equality is an integer comparison.
+//
+// InternTable::Global() returns a table shared by the whole process, which
+// lives for ever; alternatively, create an InternTable of your own, such as one
+// per request, and let it go when you're done with the strings in it.  A
+// table is thread-safe, and it never forgets a string while it exists, and so
+// every InternedString remains valid for the table's lifetime.  Reading a
+// string back from its handle, as ordering comparisons do, takes no lock,
+// and looking strings up shares a lock with other lookups.
+//
+// An InternedString is a table and a handle.  Two InternedStrings from the
+// same table are equal exactly when their handles are; otherwise, and for
+// ordering, they compare as strings, and they also compare as strings with
+// std::strings and C strings.
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+namespace P6 {
+
+class InternTable;
+
+class InternedString {
+    InternTable const *table;
+    std::uint32_t      handle;
+
+public:
+    InternedString(InternTable const &table, std::uint32_t const handle)
+        : table(&table),
+          handle(handle)   { }
+
+    InternTable const &GetTable() const {
+        return *table;
+    }
+
+    std::uint32_t GetHandle() const {
+        return handle;
+    }
+
+    inline std::string const &Str() const;
+
+    operator std::string const & () const {
+        return Str();
+    }
+
+    friend bool operator == (InternedString const &lhs, InternedString const &rhs) {
+        return lhs.table == rhs.table? lhs.handle == rhs.handle: lhs.Str() == rhs.Str();
+    }
+
+    friend bool operator != (InternedString const &lhs, InternedString const &rhs) {
+        return not(lhs == rhs);
+    }
+
+    friend bool operator < (InternedString const &lhs, InternedString const &rhs) {
+        return not(lhs.table == rhs.table and lhs.handle == rhs.handle) and lhs.Str() < rhs.Str();
+    }
+
+    friend bool operator > (InternedString const &lhs, InternedString const &rhs) {
+        return rhs < lhs;
+    }
+
+    friend bool operator <= (InternedString const &lhs, InternedString const &rhs) {
+        return not(rhs < lhs);
+    }
+
+    friend bool operator >= (InternedString const &lhs, InternedString const &rhs) {
+        return not(lhs < rhs);
+    }
+
+    friend std::ostream &operator << (std::ostream &os, InternedString const &str) {
+        return os << str.Str();
+    }
+};
+
+namespace Details {
+
+// A string's characters, where they lie, as the key of an InternTable's map:
+// a key points into one of the table's own strings, and a probe points into
+// the caller's, so that looking a C string up needn't copy it.
+struct InternKey {
+    char const  *data;
+    std::size_t  size;
+
+    friend bool operator == (InternKey const &lhs, InternKey const &rhs) {
+        return lhs.size == rhs.size and std::memcmp(lhs.data, rhs.data, lhs.size) == 0;
+    }
+};
+
+// 64-bit FNV-1a:
+struct InternKeyHash {
+    std::size_t operator () (InternKey const &key) const {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (std::size_t i = 0;  i < key.size;  ++i) {
+            hash ^= static_cast<unsigned char> (key.data[i]);
+            hash *= 1099511628211ull;
+        }
+
+        return static_cast<std::size_t> (hash);
+    }
+};
+
+}
+
+// Interning and looking strings up share a reader-writer lock, which only
+// interning a new string takes exclusively.  Turning a handle back into a
+// string takes no lock at all: the strings live in chunks that never move,
+// each twice the size of the one before, and a handle is published only
+// after its string is in place.
+class InternTable {
+    static std::size_t const FirstChunkSize = 256;
+    static std::size_t const MaxChunks      = 25;      // Enough for 2^32 handles
+
+    mutable std::shared_timed_mutex                                                mutex;
+    std::unordered_map<Details::InternKey, std::uint32_t, Details::InternKeyHash>  handles;
+    std::atomic<std::string *>                                                     chunks[MaxChunks] {};
+    std::atomic<std::uint32_t>                                                     size {0};
+
+    // Chunk k holds handles [FirstChunkSize * (2^k - 1), FirstChunkSize * (2^(k+1) - 1)):
+    static void Locate(std::uint32_t const handle, std::size_t &chunk, std::size_t &offset) {
+        auto const scaled = handle / FirstChunkSize + 1;
+        chunk = 0;
+        while ((std::size_t {2} << chunk) <= scaled)
+            ++chunk;
+
+        offset = handle - FirstChunkSize * ((std::size_t {1} << chunk) - 1);
+    }
+
+    bool FindLocked(Details::InternKey const &key, std::uint32_t &handle) const {
+        auto const found = handles.find(key);
+        if (found == handles.end())
+            return false;
+
+        handle = found->second;
+        return true;
+    }
+
+public:
+    InternTable() = default;
+    InternTable(InternTable const &) = delete;
+    InternTable &operator = (InternTable const &) = delete;
+
+    ~InternTable() {
+        for (auto &chunk: chunks)
+            delete[] chunk.load(std::memory_order_relaxed);
+    }
+
+    static InternTable &Global() {
+        static InternTable table;
+        return table;
+    }
+
+    InternedString Intern(std::string const &str) {
+        std::uint32_t handle;
+        if (Find(str, handle))
+            return InternedString(*this, handle);
+
+        std::lock_guard<std::shared_timed_mutex> const lock(mutex);
+        if (FindLocked({str.data(), str.size()}, handle))
+            return InternedString(*this, handle);
+
+        handle = size.load(std::memory_order_relaxed);
+        assert(handle < UINT32_MAX);
+
+        std::size_t chunk, offset;
+        Locate(handle, chunk, offset);
+        auto strings = chunks[chunk].load(std::memory_order_relaxed);
+        if (strings == nullptr) {
+            strings = new std::string[FirstChunkSize << chunk];
+            chunks[chunk].store(strings, std::memory_order_release);
+        }
+
+        auto &stored = strings[offset];
+        stored = str;
+        handles.emplace(Details::InternKey {stored.data(), stored.size()}, handle);
+        size.store(handle + 1, std::memory_order_release);
+        return InternedString(*this, handle);
+    }
+
+    // Look a string up without interning it, returning false if it's never
+    // been interned:
+    bool Find(char const *const data, std::size_t const length, std::uint32_t &handle) const {
+        std::shared_lock<std::shared_timed_mutex> const lock(mutex);
+        return FindLocked({data, length}, handle);
+    }
+
+    bool Find(std::string const &str, std::uint32_t &handle) const {
+        return Find(str.data(), str.size(), handle);
+    }
+
+    bool Find(char const *const str, std::uint32_t &handle) const {
+        return Find(str, std::strlen(str), handle);
+    }
+
+#if __cplusplus >= 201703L
+    bool Find(std::string_view const str, std::uint32_t &handle) const {
+        return Find(str.data(), str.size(), handle);
+    }
+#endif
+
+    std::string const &Str(std::uint32_t const handle) const {
+        assert(handle < GetSize());
+        std::size_t chunk, offset;
+        Locate(handle, chunk, offset);
+        return chunks[chunk].load(std::memory_order_acquire)[offset];
+    }
+
+    std::size_t GetSize() const {
+        return size.load(std::memory_order_acquire);
+    }
+};
+
+std::string const &InternedString::Str() const {
+    return table->Str(handle);
+}
+
+// An InternedString compares with anything that converts to a std::string, such
+// as a C string, or, with C++17, to a std::string_view, by comparing the
+// strings:
+
+namespace Details {
+
+template<typename T>
+struct IsStringLike {
+    static bool const value = not std::is_same<T, InternedString>::value and
+                              (std::is_convertible<T const &, std::string>::value
+#if __cplusplus >= 201703L
+                               or std::is_convertible<T const &, std::string_view>::value
+#endif
+                              );
+};
+
+template<typename T>
+using EnableIfStringLike = typename std::enable_if<IsStringLike<T>::value, bool>::type;
+
+}
+
+template<typename T> Details::EnableIfStringLike<T> operator == (InternedString const &lhs, T const &rhs) {return lhs.Str() == rhs;}
+template<typename T> Details::EnableIfStringLike<T> operator != (InternedString const &lhs, T const &rhs) {return lhs.Str() != rhs;}
+template<typename T> Details::EnableIfStringLike<T> operator <  (InternedString const &lhs, T const &rhs) {return lhs.Str() <  rhs;}
+template<typename T> Details::EnableIfStringLike<T> operator <= (InternedString const &lhs, T const &rhs) {return lhs.Str() <= rhs;}
+template<typename T> Details::EnableIfStringLike<T> operator >  (InternedString const &lhs, T const &rhs) {return lhs.Str() >  rhs;}
+template<typename T> Details::EnableIfStringLike<T> operator >= (InternedString const &lhs, T const &rhs) {return lhs.Str() >= rhs;}
+
+template<typename T> Details::EnableIfStringLike<T> operator == (T const &lhs, InternedString const &rhs) {return lhs == rhs.Str();}
+template<typename T> Details::EnableIfStringLike<T> operator != (T const &lhs, InternedString const &rhs) {return lhs != rhs.Str();}
+template<typename T> Details::EnableIfStringLike<T> operator <  (T const &lhs, InternedString const &rhs) {return lhs <  rhs.Str();}
+template<typename T> Details::EnableIfStringLike<T> operator <= (T const &lhs, InternedString const &rhs) {return lhs <= rhs.Str();}
+template<typename T> Details::EnableIfStringLike<T> operator >  (T const &lhs, InternedString const &rhs) {return lhs >  rhs.Str();}
+template<typename T> Details::EnableIfStringLike<T> operator >= (T const &lhs, InternedString const &rhs) {return lhs >= rhs.Str();}
+
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionIteratorStore_h
+#define      P6JunctionIteratorStore_h
+
+// Stores a Junction's elements by reference to a range delimited by a pair of
+// iterators passed in by the caller, without copying them.  This is the
+// iterator-pair equivalent of JunctionPiggyBackStore, and, as with that class,
+// the caller must keep the underlying elements alive, and the iterators
+// valid, for as long as the junction is in use.
+//
+// Unless the caller vouches for the range's being in ascending order, by
+// passing P6::sorted, nothing is assumed about the order of the elements, and
+// so comparisons scan the range, just as they would scan a whole container.
+// For random-access iterators, including pointers and std::vector iterators,
+// the scans are as tight as they are over the container itself, and the size
+// is known in constant time.  A sorted range must have at least bidirectional
+// iterators.
+
+#include "JunctionRange.h"
+
+#include <cassert>
+#include <iterator>
+#include <type_traits>
+
+namespace P6 { namespace Details {
+
+template<typename Iterator, bool IsOrdered = false>
+class JunctionIteratorStore {
+public:
+    using Element             = typename std::remove_const<typename std::iterator_traits<Iterator>::value_type>::type;
+    static bool const Ordered = IsOrdered;
+    static bool const Indexed = false;
+
+private:
+    JunctionRange<Iterator> range;
+
+    // Iterators that return their elements by value, or through proxies, as
+    // std::vector<bool>'s do, leave nothing for a reference to refer to once
+    // the expression ends, and so we return such elements by value:
+    using ElementRef = typename std::conditional<
+        std::is_lvalue_reference<typename std::iterator_traits<Iterator>::reference>::value,
+        Element const &,
+        Element
+    >::type;
+
+protected:
+    JunctionIteratorStore(Iterator const begin, Iterator const end)
+        : range(begin, end)   { }
+
+    Element const GetAnyElement() const {
+        return *range.begin();
+    }
+
+public:
+    JunctionRange<Iterator> const &Elements() const {
+        return range;
+    }
+
+    bool IsEmpty() const {
+        return range.empty();
+    }
+
+    auto GetSize() const {
+        return range.size();
+    }
+
+    bool HasSecondElement() const {
+        return not IsEmpty() and std::next(range.begin()) != range.end();
+    }
+
+protected:
+    ElementRef FirstElement() const {
+        assert(not IsEmpty());
+        return *range.begin();
+    }
+
+    ElementRef SecondElement() const {
+        assert(HasSecondElement());
+        return *std::next(range.begin());
+    }
+
+    ElementRef PenultimateElement() const {
+        assert(HasSecondElement());
+        return *std::prev(range.end(), 2);
+    }
+
+    ElementRef LastElement() const {
+        assert(not IsEmpty());
+        return *std::prev(range.end());
+    }
+};
+
+} }
+
+#endif
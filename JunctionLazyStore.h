@@ -0,0 +1,128 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionLazyStore_h
+#define      P6JunctionLazyStore_h
+
+// Stores a copy of a Junction's elements in an unsorted std::vector, and finds
+// the two lowest and two highest distinct elements only when an ordering
+// comparison first asks for one of them.  A junction that's copied for safety
+// but only ever compared for equality, which scans the vector, never pays for
+// ordering at all; one that is compared for ordering pays a single linear pass
+// on the first comparison, and from then on takes the same constant-time fast
+// paths as a sorted copy.
+//
+// The first ordering comparison may come from several threads at once, and so
+// the extremes are found under std::call_once.
+//
+// Like JunctionExtremesStore, this keeps duplicates, and so it suits All-,
+// Any- and None-junctions but not One-junctions, and its vector can take its
+// memory from any standard allocator.
+
+#include "JunctionExtremesStore.h"
+
+#include <cassert>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace P6 { namespace Details {
+
+template<typename T, typename Alloc = std::allocator<T>>
+class JunctionLazyStore {
+public:
+    using Element             = T;
+    using Allocator           = Alloc;
+    static bool const Ordered = true;
+    static bool const Indexed = false;
+
+private:
+    std::vector<Element, Allocator> elements;
+    mutable std::once_flag          found;
+    mutable Extremes<Element>       extremes;
+
+    Extremes<Element> const &GetExtremes() const {
+        std::call_once(found, [this] () {extremes.Find(elements);});
+        return extremes;
+    }
+
+public:
+    JunctionLazyStore(std::initializer_list<Element> const ilist, Allocator const &allocator = Allocator())
+        : elements(ilist, allocator)   { }
+
+    template<typename Iterator>
+    JunctionLazyStore(Iterator const begin, Iterator const end, Allocator const &allocator = Allocator())
+        : elements(begin, end, allocator)   { }
+
+    // Adopt a vector's buffer, and its allocator:
+    JunctionLazyStore(std::vector<Element, Allocator> &&elements)
+        : elements(std::move(elements))   { }
+
+    // A std::once_flag can be neither copied nor moved, and so a copy starts
+    // afresh, and finds the extremes again if it needs them:
+    JunctionLazyStore(JunctionLazyStore const &other)
+        : elements(other.elements)   { }
+
+    JunctionLazyStore(JunctionLazyStore &&other)
+        : elements(std::move(other.elements))   { }
+
+    std::vector<Element, Allocator> const &Elements() const {
+        return elements;
+    }
+
+    Allocator GetAllocator() const {
+        return elements.get_allocator();
+    }
+
+    bool IsEmpty() const {
+        return elements.empty();
+    }
+
+    bool HasSecondElement() const {
+        return GetExtremes().has_second;
+    }
+
+protected:
+    Element const &FirstElement() const {
+        assert(not IsEmpty());
+        return GetExtremes().first;
+    }
+
+    Element const &SecondElement() const {
+        assert(HasSecondElement());
+        return GetExtremes().second;
+    }
+
+    Element const &PenultimateElement() const {
+        assert(HasSecondElement());
+        return GetExtremes().penultimate;
+    }
+
+    Element const &LastElement() const {
+        assert(not IsEmpty());
+        return GetExtremes().last;
+    }
+
+    Element const &GetAnyElement() const {
+        assert(not IsEmpty());
+        return elements.front();
+    }
+};
+
+} }
+
+#endif
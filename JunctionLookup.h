@@ -0,0 +1,97 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionLookup_h
+#define      P6JunctionLookup_h
+
+// Some stores can look an element up without scanning for it: a sorted store
+// can use a binary search, and a hash store can use its hash table.  Such a
+// store declares itself Indexed, and provides Contains(), which returns true
+// if the store holds an element equal to its argument.  GetSize() must return
+// the number of distinct elements, because that lets junctions answer == and
+// != by counting, and an Indexed store must normally be deduplicated too; see
+// StoreIsDeduplicated below for the exception.
+//
+// This header decides when a junction may use Contains() instead of scanning.
+
+#include "JunctionReverseComparisons.h"
+
+#include <type_traits>
+
+namespace P6 { namespace Details {
+
+// Looking a value up converts it to the store's element type, and that's safe
+// only if the conversion gives the same answer as the scan, which compares
+// each element with the value directly.  We allow it when the types are the
+// same; when both are arithmetic and the usual arithmetic conversions would
+// convert the value to the element type anyway, as they convert an int to an
+// unsigned; or when neither is arithmetic and the value converts implicitly,
+// as a char const * converts to a std::string.  Other mixtures, such as
+// (2.5 == any({2, 3})), are left to the scan.
+
+template<typename Element, typename Value>
+struct IsLookupCompatible {
+    using V = typename std::decay<Value>::type;
+
+    template<typename E, typename W, bool BothArithmetic = std::is_arithmetic<E>::value and std::is_arithmetic<W>::value>
+    struct ConvertsLikeAScan {
+        static bool const value = std::is_same<typename std::common_type<E, W>::type, E>::value;
+    };
+
+    template<typename E, typename W>
+    struct ConvertsLikeAScan<E, W, false> {
+        static bool const value = not std::is_arithmetic<E>::value and
+                                  not std::is_arithmetic<W>::value and
+                                  std::is_convertible<W, E>::value;
+    };
+
+    static bool const value = std::is_same<Element, V>::value or ConvertsLikeAScan<Element, V>::value;
+};
+
+// A store can specialise this if its Contains() method accepts more types
+// than IsLookupCompatible allows:
+
+template<typename Store, typename Value>
+struct StoreCanLookUp: IsLookupCompatible<typename Store::Element, Value> { };
+
+// A junction can look up a single value, but never another junction:
+
+template<typename Store, typename Value>
+struct CanLookUp {
+    static bool const value = Store::Indexed               and
+                              not IsJunction<Value>::value and
+                              StoreCanLookUp<Store, Value>::value;
+};
+
+// A store that summarises a container it doesn't own, such as
+// JunctionVersionedPiggyBackStore, may be Indexed even though the container
+// holds duplicates: Contains() and GetSize() then describe the distinct
+// values.  That's all that any-, none- and all-junctions need, because their
+// answers don't depend on how often a value occurs, but a one-junction counts
+// occurrences, and so it looks values up only in a deduplicated store.  Such
+// stores specialise this:
+
+template<typename Store>
+struct StoreIsDeduplicated: std::true_type { };
+
+template<typename Store, typename Value>
+struct CanCountByLookUp {
+    static bool const value = CanLookUp<Store, Value>::value and StoreIsDeduplicated<Store>::value;
+};
+
+} }
+
+#endif
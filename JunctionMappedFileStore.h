@@ -0,0 +1,293 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionMappedFileStore_h
+#define      P6JunctionMappedFileStore_h
+
+// Stores a Junction's elements by mapping a file of fixed-width, little-endian
+// integers or floating-point numbers into memory, read-only.  Nothing is
+// copied or parsed, and so a junction of tens of millions of ids is ready as
+// soon as the file is open, and its pages are shared with every other process
+// that maps the same file.
+//
+// The file may begin with the header described in JunctionSnapshot.h, which
+// records the width and kind of the elements, how many there are, and whether
+// they're sorted and unique; P6::Save() writes such files.  A file without the
+// header holds nothing but elements.
+//
+// A junction over a file whose elements are sorted and unique gets the same
+// optimisations as a sorted copy, including binary searches for equality:
+// pass P6::sorted to the helper functions, as in
+// any_mapped<std::uint64_t>(P6::sorted, path).  The header, if there is one,
+// must agree, and then the promise costs nothing; without a header, define
+// P6_CHECK_SORTED to have debug builds check it.
+//
+// The helper functions tell the kernel how the pages will be read: in order,
+// for scans, by default, or at random, for the binary searches of a sorted
+// file.  If the file has an index, lookups search it first, and then only one
+// block of elements.  Failing to open or map the file throws
+// std::system_error, and a file whose header doesn't match the element type
+// throws std::runtime_error.
+//
+// This needs mmap(), and so it's available only on Unix-like systems.
+
+#if defined __unix__ || defined __APPLE__
+#define P6_HAVE_MMAP
+#endif
+
+#if defined P6_HAVE_MMAP
+
+#include "JunctionRange.h"
+#include "JunctionSnapshot.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace P6 {
+
+// How the pages of a mapped file will be read:
+enum class AccessHint {Normal, Sequential, Random};
+
+namespace Details {
+
+// Maps a whole file, read-only, and unmaps it on destruction:
+class FileMapping {
+    void        *address;
+    std::size_t  length;
+
+    [[noreturn]] static void Fail(std::string const &what, std::string const &path) {
+        throw std::system_error(errno, std::generic_category(), what + ' ' + path);
+    }
+
+    void Map(int const fd, std::string const &path, AccessHint const hint) {
+        struct stat status;
+        if (::fstat(fd, &status) != 0)
+            Fail("Can't stat", path);
+
+        // mmap() refuses to map nothing:
+        length = static_cast<std::size_t> (status.st_size);
+        if (length != 0) {
+            address = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+            if (address == MAP_FAILED)
+                Fail("Can't map", path);
+
+            // The advice is only advice, and so we needn't know whether it was
+            // taken:
+            int const advice = hint == AccessHint::Sequential? MADV_SEQUENTIAL:
+                               hint == AccessHint::Random?     MADV_RANDOM:
+                                                               MADV_NORMAL;
+            ::madvise(address, length, advice);
+        }
+    }
+
+public:
+    FileMapping(std::string const &path, AccessHint const hint)
+        : address(nullptr),
+          length(0) {
+        int const fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            Fail("Can't open", path);
+
+        try {
+            Map(fd, path, hint);
+        }
+        catch (...) {
+            ::close(fd);
+            throw;
+        }
+
+        ::close(fd);
+    }
+
+    // Map a file that's already open, such as a shared-memory object; the
+    // caller still owns the descriptor, which can be closed straight away.
+    // The name is used only in error messages.
+    FileMapping(int const fd, std::string const &name, AccessHint const hint)
+        : address(nullptr),
+          length(0) {
+        Map(fd, name, hint);
+    }
+
+    FileMapping(FileMapping const &) = delete;
+    FileMapping &operator = (FileMapping const &) = delete;
+
+    ~FileMapping() {
+        if (length != 0)
+            ::munmap(address, length);
+    }
+
+    unsigned char const *GetBytes() const {
+        return static_cast<unsigned char const *> (address);
+    }
+
+    std::size_t GetLength() const {
+        return length;
+    }
+};
+
+// A mapped file of elements, found after the header if there is one.  Copies
+// of a junction share one of these.
+template<typename T>
+class MappedElements {
+    FileMapping    mapping;
+    SnapshotLayout layout;
+
+public:
+    MappedElements(std::string const &path, AccessHint const hint)
+        : mapping(path, hint),
+          layout(SnapshotLayout::Find<T> (mapping.GetBytes(), mapping.GetLength(), path))   { }
+
+    MappedElements(int const fd, std::string const &name, AccessHint const hint)
+        : mapping(fd, name, hint),
+          layout(SnapshotLayout::Find<T> (mapping.GetBytes(), mapping.GetLength(), name))   { }
+
+    // Check the caller's promise that the elements are sorted and unique: a
+    // header must agree, and a file without one is checked if P6_CHECK_SORTED
+    // is defined.
+    void CheckSortedAndUnique(std::string const &path) const {
+        auto const sorted_and_unique = MappedFileHeader::Sorted | MappedFileHeader::Unique;
+        if (layout.has_header and (layout.flags & sorted_and_unique) != sorted_and_unique)
+            RejectSnapshot(path, "header doesn't say that the elements are sorted and unique");
+
+#if defined P6_CHECK_SORTED
+        assert(std::adjacent_find(GetData(), GetData() + GetSize(), std::greater_equal<T> ()) == GetData() + GetSize());
+#endif
+    }
+
+    T const *GetData() const {
+        return reinterpret_cast<T const *> (mapping.GetBytes() + layout.elements_offset);
+    }
+
+    std::size_t GetSize() const {
+        return layout.nr_elements;
+    }
+
+    // Search sorted elements, using the index if there is one:
+    bool Contains(T const &value) const {
+        auto const data = GetData();
+        if (layout.index_size == 0)
+            return std::binary_search(data, data + GetSize(), value);
+
+        auto const index = reinterpret_cast<T const *> (mapping.GetBytes() + layout.index_offset);
+        auto const entry = std::upper_bound(index, index + layout.index_size, value);
+        if (entry == index)
+            return false;
+
+        auto const first = static_cast<std::size_t> (entry - index - 1) * MappedFileHeader::IndexStride;
+        auto const last  = std::min(first + MappedFileHeader::IndexStride, GetSize());
+        return std::binary_search(data + first, data + last, value);
+    }
+};
+
+template<typename T, bool IsOrdered>
+class JunctionMappedFileStore {
+public:
+    using Element             = T;
+    static bool const Ordered = IsOrdered;
+    static bool const Indexed = IsOrdered;
+
+private:
+    std::shared_ptr<MappedElements<T> const> file;
+
+    T const *Begin() const {
+        return file->GetData();
+    }
+
+    T const *End() const {
+        return file->GetData() + file->GetSize();
+    }
+
+public:
+    JunctionMappedFileStore(std::string const &path, AccessHint const hint)
+        : file(std::make_shared<MappedElements<T>> (path, hint)) {
+        if (IsOrdered)
+            file->CheckSortedAndUnique(path);
+    }
+
+    // Adopt a file that's already mapped:
+    JunctionMappedFileStore(std::shared_ptr<MappedElements<T> const> file, std::string const &name)
+        : file(std::move(file)) {
+        if (IsOrdered)
+            this->file->CheckSortedAndUnique(name);
+    }
+
+    JunctionRange<T const *> Elements() const {
+        return {Begin(), End()};
+    }
+
+    bool IsEmpty() const {
+        return file->GetSize() == 0;
+    }
+
+    std::size_t GetSize() const {
+        return file->GetSize();
+    }
+
+    bool HasSecondElement() const {
+        return file->GetSize() >= 2;
+    }
+
+    bool Contains(Element const &value) const {
+        assert(IsOrdered);
+        return file->Contains(value);
+    }
+
+protected:
+    Element const &FirstElement() const {
+        assert(not IsEmpty());
+        return *Begin();
+    }
+
+    Element const &SecondElement() const {
+        assert(HasSecondElement());
+        return Begin()[1];
+    }
+
+    Element const &PenultimateElement() const {
+        assert(HasSecondElement());
+        return End()[-2];
+    }
+
+    Element const &LastElement() const {
+        assert(not IsEmpty());
+        return End()[-1];
+    }
+
+    Element const &GetAnyElement() const {
+        return FirstElement();
+    }
+};
+
+} }
+
+#endif
+
+#endif
@@ -21,9 +21,30 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 // one of its members.
 
 #include "Junction.h"
+#include "JunctionAllocator.h"
+#include "JunctionBitsetStore.h"
+#include "JunctionColumnStore.h"
+#include "JunctionConstantStore.h"
+#include "JunctionEnumStore.h"
+#include "JunctionEytzingerStore.h"
+#include "JunctionFlatSortedStore.h"
+#include "JunctionHashStore.h"
+#include "JunctionInternStore.h"
+#include "JunctionIteratorStore.h"
+#include "JunctionLookup.h"
+#include "JunctionMappedFileStore.h"
+#include "JunctionOrderedPiggyBackStore.h"
+#include "JunctionPackedStore.h"
 #include "JunctionPiggyBackStore.h"
+#include "JunctionProjectionStore.h"
 #include "JunctionReverseComparisons.h"
+#include "JunctionRoaringStore.h"
+#include "JunctionScan.h"
+#include "JunctionSharedStore.h"
+#include "JunctionSnapshot.h"
 #include "JunctionSortedStore.h"
+#include "JunctionStoreSelection.h"
+#include "JunctionVersionedPiggyBackStore.h"
 
 namespace P6 {
 
@@ -33,7 +54,7 @@ class One: public Junction<Store> {
     using Element = typename Jct::Element;
 
 public:
-    // True if the junction copied the elements into a new std::set on
+    // True if the junction copied the elements into sorted storage on
     // construction, enabling some optimisations:
     static bool constexpr Ordered = Store::Ordered;
 
@@ -44,8 +65,14 @@ public:
     template<typename Container>
     explicit One(Container const &container):                   Jct(container)   { }
 
-    template<typename Elt>
-    explicit One(std::set<Elt> &&container):                    Jct(std::move(container))   { }
+    template<typename Elt, typename Less, typename Alloc>
+    explicit One(std::set<Elt, Less, Alloc> &&container):       Jct(std::move(container))   { }
+
+    template<typename Elt, typename Alloc>
+    explicit One(std::vector<Elt, Alloc> &&container):          Jct(std::move(container))   { }
+
+    template<typename... Args>
+    constexpr explicit One(Details::InPlaceTag const tag, Args &&...args): Jct(tag, std::forward<Args>(args)...)   { }
 
     template<typename Iterator>
     One(Iterator const begin, Iterator const end):              Jct(begin, end)   { }
@@ -57,7 +84,7 @@ public:
     template<typename Lambda>
     auto operator () (Lambda const &lambda) const {
         using ResultElement = decltype(lambda(Jct::GetAnyElement()));
-        using Result        = One<Details::JunctionSortedStore<ResultElement>>;
+        using Result        = One<typename Details::MappedStore<Store, ResultElement>::type>;
         return Jct::template Map<Result> (lambda);
     }
 
@@ -66,7 +93,7 @@ public:
         return JunctionType::One;
     }
 
-    // Because std::set stores elements in ascending order, many of these
+    // Because sorted stores hold elements in ascending order, many of these
     // comparison operators need look at only the first or last element when
     // the backing store is sorted.
     //
@@ -88,20 +115,14 @@ public:
 private:
     template<typename Lambda>
     bool CheckAllElements(Lambda const &lambda) const {
-        unsigned matches {0};
-        for (auto const &elem: Jct::Elements())
-            if (lambda(elem))
-                if (++matches > 1)
-                    return false;
-
-        return matches == 1;
+        return Details::OneMatches(Jct::Elements(), lambda);
     }
 
 public:
     // <
 
     template<typename NoneStore>
-    typename Details::EnableIf2<Ordered, bool, NoneStore>::type operator < (None<NoneStore> const &rhs) const {
+    constexpr typename Details::EnableIf2<Ordered, bool, NoneStore>::type operator < (None<NoneStore> const &rhs) const {
         return not Jct::IsEmpty()       and
                Jct::LastElement() < rhs and
                not(Jct::HasSecondElement() and Jct::PenultimateElement() < rhs); 
@@ -113,7 +134,7 @@ public:
     }
 
     template<typename ElementOrJunction>
-    typename Details::EnableIf2<Ordered, bool, ElementOrJunction>::type operator < (ElementOrJunction const &rhs) const {
+    constexpr typename Details::EnableIf2<Ordered, bool, ElementOrJunction>::type operator < (ElementOrJunction const &rhs) const {
         return not Jct::IsEmpty()           and
                Jct::FirstElement() < rhs   and
                not(Jct::HasSecondElement() and Jct::SecondElement() < rhs);
@@ -127,7 +148,7 @@ public:
     // <=
 
     template<typename NoneStore>
-    typename Details::EnableIf2<Store::Ordered, bool, NoneStore>::type operator <= (None<NoneStore> const &rhs) const {
+    constexpr typename Details::EnableIf2<Store::Ordered, bool, NoneStore>::type operator <= (None<NoneStore> const &rhs) const {
         return not Jct::IsEmpty()       and
                Jct::LastElement() <= rhs and
                not(Jct::HasSecondElement() and Jct::PenultimateElement() <= rhs); 
@@ -139,7 +160,7 @@ public:
     }
 
     template<typename ElementOrJunction>
-    typename Details::EnableIf2<Store::Ordered, bool, ElementOrJunction>::type operator <= (ElementOrJunction const &rhs) const {
+    constexpr typename Details::EnableIf2<Store::Ordered, bool, ElementOrJunction>::type operator <= (ElementOrJunction const &rhs) const {
         return not Jct::IsEmpty()           and
                Jct::FirstElement() <= rhs   and
                not(Jct::HasSecondElement() and Jct::SecondElement() <= rhs);
@@ -152,16 +173,31 @@ public:
 
     // ==, !=
 
-    // There's no short-cut when we check for equality or inequality:
+    // An Indexed, deduplicated store can look a single value up instead of
+    // scanning for it.  Its elements are distinct, and so exactly one of them
+    // equals the value if it's present at all, and exactly one differs from it
+    // if there's one more element than there are equal ones:
+
+    template<typename ElementOrJunction>
+    constexpr typename Details::EnableIf2<Details::CanCountByLookUp<Store, ElementOrJunction>::value, bool, ElementOrJunction>::type operator == (ElementOrJunction const &rhs) const {
+        return Jct::Contains(rhs);
+    }
+
+    template<typename ElementOrJunction>
+    constexpr typename Details::EnableIf2<Details::CanCountByLookUp<Store, ElementOrJunction>::value, bool, ElementOrJunction>::type operator != (ElementOrJunction const &rhs) const {
+        return Jct::GetSize() - (Jct::Contains(rhs)? 1u: 0u) == 1u;
+    }
+
+    // Otherwise, there's no short-cut when we check for equality or inequality:
     template<typename ElementOrJunction>
-    bool operator == (ElementOrJunction const &rhs) const {
+    typename Details::EnableIf2<not Details::CanCountByLookUp<Store, ElementOrJunction>::value, bool, ElementOrJunction>::type operator == (ElementOrJunction const &rhs) const {
         return CheckAllElements([&rhs] (Element const &elem) {return elem == rhs;});
     }
 
     // operator != can't be a straight negation of operator ==, because
     // (all(1, 2) == 2) and (all(1, 2) != 2) are both false.
     template<typename ElementOrJunction>
-    bool operator != (ElementOrJunction const &rhs) const {
+    typename Details::EnableIf2<not Details::CanCountByLookUp<Store, ElementOrJunction>::value, bool, ElementOrJunction>::type operator != (ElementOrJunction const &rhs) const {
         return CheckAllElements([&rhs] (Element const &elem) {return elem != rhs;});
     }
 
@@ -171,7 +207,7 @@ public:
     // (all(1, 2) < 2) and (all(1, 2) >= 2) are both false.
 
     template<typename NoneStore>
-    typename Details::EnableIf2<Store::Ordered, bool, NoneStore>::type operator >= (None<NoneStore> const &rhs) const {
+    constexpr typename Details::EnableIf2<Store::Ordered, bool, NoneStore>::type operator >= (None<NoneStore> const &rhs) const {
         return not Jct::IsEmpty()       and
         Jct::FirstElement() >= rhs       and
         not (Jct::HasSecondElement() and Jct::SecondElement() >= rhs);
@@ -183,7 +219,7 @@ public:
     }
 
     template<typename ElementOrJunction>
-    typename Details::EnableIf2<Store::Ordered, bool, ElementOrJunction>::type operator >= (ElementOrJunction const &rhs) const {
+    constexpr typename Details::EnableIf2<Store::Ordered, bool, ElementOrJunction>::type operator >= (ElementOrJunction const &rhs) const {
         return not Jct::IsEmpty()           and
                Jct::LastElement() >= rhs    and
                not(Jct::HasSecondElement() and Jct::PenultimateElement() >= rhs); 
@@ -199,7 +235,7 @@ public:
     // This can't be a straight negation of operator <=, because
     // (all(1, 2, 3) <= 2) and (all(1, 2, 3) > 2) are both false.
     template<typename NoneStore>
-    typename Details::EnableIf2<Store::Ordered, bool, NoneStore>::type operator > (None<NoneStore> const &rhs) const {
+    constexpr typename Details::EnableIf2<Store::Ordered, bool, NoneStore>::type operator > (None<NoneStore> const &rhs) const {
         return not Jct::IsEmpty()       and
         Jct::FirstElement() > rhs       and
         not (Jct::HasSecondElement() and Jct::SecondElement() > rhs);
@@ -211,7 +247,7 @@ public:
     }
 
     template<typename ElementOrJunction>
-    typename Details::EnableIf2<Store::Ordered, bool, ElementOrJunction>::type operator > (ElementOrJunction const &rhs) const {
+    constexpr typename Details::EnableIf2<Store::Ordered, bool, ElementOrJunction>::type operator > (ElementOrJunction const &rhs) const {
         return not Jct::IsEmpty()           and
                Jct::LastElement() > rhs     and
                not(Jct::HasSecondElement() and Jct::PenultimateElement() > rhs); 
@@ -242,8 +278,8 @@ auto one_ref(std::initializer_list<Element> const &ilist) {
 
 template<typename Element>
 auto one_copy(std::initializer_list<Element> ilist) {
-    using Store = Details::JunctionSortedStore<Element>;
-    return One<Store> (ilist);
+    using Store = Details::InitializerListStore<Details::CopiedElement<Element>>;
+    return One<Store> (ilist.begin(), ilist.end());
 }
 
 // Temporaries get copied by default:
@@ -273,7 +309,7 @@ auto one(std::initializer_list<Element> const &ilist) {
 
 template<typename Container>
 auto one_ref(Container const &container) {
-    using Store = Details::JunctionPiggyBackStore<Container>;
+    using Store = Details::PiggyBackStoreFor<Container>;
     return One<Store> (container);
 }
 
@@ -282,7 +318,7 @@ auto one_ref(Container const &container) {
 template<typename Container>
 auto one_copy(Container const &container) {
     using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
-    using Store = Details::JunctionSortedStore<Element>;
+    using Store = Details::CopyStoreFor<Details::CopiedElement<Element>>;
     return One<Store> (container.begin(), container.end());
 }
 
@@ -309,12 +345,28 @@ auto one(Container const &container) {
 // Iterator pairs:
 //
 
-// For now, a pair of iterators causes a copy, although that'll change in time:
+// Force the absence of a copy:
 
 template<typename Iterator>
-auto one(Iterator const begin, Iterator const end) {
+auto one_ref(Iterator const begin, Iterator const end) {
+    using Store = Details::JunctionIteratorStore<Iterator>;
+    return One<Store> (begin, end);
+}
+
+// Force a copy:
+
+template<typename Iterator>
+auto one_copy(Iterator const begin, Iterator const end) {
     using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
-    return One<Details::JunctionSortedStore<Element>> (begin, end);
+    using Store = Details::CopyStoreFor<Details::CopiedElement<Element>>;
+    return One<Store> (begin, end);
+}
+
+// As with named containers, a pair of iterators doesn't get copied by default:
+
+template<typename Iterator>
+auto one(Iterator const begin, Iterator const end) {
+    return one_ref(begin, end);
 }
 
 //
@@ -330,8 +382,640 @@ auto one(std::set<Element> &&elements) {
     return One<Details::JunctionSortedStore<Element>> (std::move(elements));
 }
 
-// TODO: assume a named std::set is sorted, too, and piggyback on it, rather
-// than copying it and assuming it's unsorted, which is doubly bad.
+// A named std::set, and any other container for which IsSortedContainer is
+// true, is piggybacked on by JunctionOrderedPiggyBackStore, which can take
+// advantage of its sortedness without copying it.
+
+//
+// Vectors:
+//
+
+// A temporary std::vector of elements that would be copied into a sorted
+// vector is moved into one instead, and sorted and deduplicated in place, so
+// that no memory is allocated.
+
+template<typename Element, typename Alloc, typename Store = Details::AdoptedVectorStore<Element, Alloc>>
+auto one(std::vector<Element, Alloc> &&elements) {
+    return One<Store> (std::move(elements));
+}
+
+//
+// Input that the caller promises is sorted:
+//
+
+// Named containers and pairs of iterators are piggybacked on, as usual, but
+// with the optimisations normally reserved for copies:
+
+template<typename Container>
+auto one(SortedTag, Container &container) {
+    Details::CheckSorted(std::begin(container), std::end(container));
+    using Store = Details::JunctionOrderedPiggyBackStore<Container>;
+    return One<Store> (container);
+}
+
+template<typename Container>
+auto one(SortedTag, Container const &container) {
+    Details::CheckSorted(std::begin(container), std::end(container));
+    using Store = Details::JunctionOrderedPiggyBackStore<Container>;
+    return One<Store> (container);
+}
+
+template<typename Iterator>
+auto one(SortedTag, Iterator const begin, Iterator const end) {
+    Details::CheckSorted(begin, end);
+    using Store = Details::JunctionIteratorStore<Iterator, true>;
+    return One<Store> (begin, end);
+}
+
+// A temporary vector is adopted without being sorted again.  Any other
+// temporary container is checked, then copied and sorted as usual:
+
+template<typename Container>
+auto one(SortedTag, Container &&container) {
+    Details::CheckSorted(std::begin(container), std::end(container));
+    return one_copy(container);
+}
+
+template<typename Element, typename Alloc, typename Store = Details::AdoptedVectorStore<Element, Alloc>>
+auto one(SortedTag, std::vector<Element, Alloc> &&elements) {
+    Details::CheckSorted(elements.begin(), elements.end());
+    return One<Store> (std::move(elements));
+}
+
+//
+// Hashed copies:
+//
+
+// Copy the elements into a hash table, so that == and != against single
+// values take O(1) expected time -- see JunctionAny.h:
+
+template<typename Element>
+auto one_hash(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionHashStore<Details::CopiedElement<Element>>;
+    return One<Store> (ilist.begin(), ilist.end());
+}
+
+template<typename Container>
+auto one_hash(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionHashStore<Details::CopiedElement<Element>>;
+    return One<Store> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto one_hash(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionHashStore<Details::CopiedElement<Element>>;
+    return One<Store> (begin, end);
+}
+
+//
+// Bitsets:
+//
+
+// Copy the elements into a bitset with one bit for each of DomainSize values,
+// starting from zero, so that comparisons with single values take constant
+// time.  Types such as uint8_t get a bitset covering all their values by
+// default when they're copied, and there's no need to specify a DomainSize for
+// them here.
+
+template<std::size_t DomainSize = 0, typename Element>
+auto one_bitset(std::initializer_list<Element> const ilist) {
+    using Store = Details::BitsetStoreFor<Element, DomainSize>;
+    return One<Store> (ilist);
+}
+
+template<std::size_t DomainSize = 0, typename Container>
+auto one_bitset(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::BitsetStoreFor<Element, DomainSize>;
+    return One<Store> (container.begin(), container.end());
+}
+
+//
+// Compressed bitmaps:
+//
+
+// Copy integers of up to 32 bits into a compressed bitmap, which takes far
+// less memory than a std::set or a sorted vector when there are millions of
+// them, and still gives O(log N) lookups and O(1) ordering comparisons:
+
+template<typename Element>
+auto one_roaring(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionRoaringStore<Element>;
+    return One<Store> (ilist);
+}
+
+template<typename Container>
+auto one_roaring(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionRoaringStore<Element>;
+    return One<Store> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto one_roaring(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionRoaringStore<Element>;
+    return One<Store> (begin, end);
+}
+
+//
+// Eytzinger layout:
+//
+
+// Copy the elements into an implicit search tree laid out for the cache, for
+// large junctions that are built once and compared with single values many
+// times; see JunctionEytzingerStore.h:
+
+template<typename Element>
+auto one_eytzinger(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionEytzingerStore<Element>;
+    return One<Store> (ilist);
+}
+
+template<typename Container>
+auto one_eytzinger(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionEytzingerStore<Element>;
+    return One<Store> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto one_eytzinger(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionEytzingerStore<Element>;
+    return One<Store> (begin, end);
+}
+
+//
+// Packed copies:
+//
+
+// Copy integers into sorted, delta-encoded blocks, which take a fraction of
+// the memory of a std::set or a sorted vector when neighbouring elements are
+// close together, as timestamps and sequential ids usually are:
+
+template<typename Element>
+auto one_packed(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionPackedStore<Element>;
+    return One<Store> (ilist);
+}
+
+template<typename Container>
+auto one_packed(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionPackedStore<Element>;
+    return One<Store> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto one_packed(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionPackedStore<Element>;
+    return One<Store> (begin, end);
+}
+
+//
+// Copies that take memory from an allocator, an arena or, in C++17, a
+// std::pmr::memory_resource -- see JunctionAllocator.h:
+//
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_copy(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionFlatSortedStore<Element, Allocator>;
+    return One<Store> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_copy(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionFlatSortedStore<Element, Allocator>;
+    return One<Store> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_copy(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionFlatSortedStore<Element, Allocator>;
+    return One<Store> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_hash(std::initializer_list<Element> const ilist, Source &&source) {
+    using Copied = Details::CopiedElement<Element>;
+    using Allocator = Details::AllocatorFor<Copied, Source>;
+    using Store = Details::JunctionHashStore<Copied, std::hash<Copied>, Allocator>;
+    return One<Store> (Details::in_place, ilist.begin(), ilist.end(), Details::MakeAllocator<Copied> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_hash(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Copied = Details::CopiedElement<Element>;
+    using Allocator = Details::AllocatorFor<Copied, Source>;
+    using Store = Details::JunctionHashStore<Copied, std::hash<Copied>, Allocator>;
+    return One<Store> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Copied> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_hash(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Copied = Details::CopiedElement<Element>;
+    using Allocator = Details::AllocatorFor<Copied, Source>;
+    using Store = Details::JunctionHashStore<Copied, std::hash<Copied>, Allocator>;
+    return One<Store> (Details::in_place, begin, end, Details::MakeAllocator<Copied> (source));
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_roaring(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionRoaringStore<Element, Allocator>;
+    return One<Store> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_roaring(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionRoaringStore<Element, Allocator>;
+    return One<Store> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_roaring(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionRoaringStore<Element, Allocator>;
+    return One<Store> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_eytzinger(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionEytzingerStore<Element, Allocator>;
+    return One<Store> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_eytzinger(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionEytzingerStore<Element, Allocator>;
+    return One<Store> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_eytzinger(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionEytzingerStore<Element, Allocator>;
+    return One<Store> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Element, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_packed(std::initializer_list<Element> const ilist, Source &&source) {
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionPackedStore<Element, Allocator>;
+    return One<Store> (Details::in_place, ilist, Details::MakeAllocator<Element> (source));
+}
+
+template<typename Container, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_packed(Container const &container, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionPackedStore<Element, Allocator>;
+    return One<Store> (Details::in_place, container.begin(), container.end(), Details::MakeAllocator<Element> (source));
+}
+
+template<typename Iterator, typename Source, typename = Details::EnableIfAllocatorSource<Source>>
+auto one_packed(Iterator const begin, Iterator const end, Source &&source) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Allocator = Details::AllocatorFor<Element, Source>;
+    using Store = Details::JunctionPackedStore<Element, Allocator>;
+    return One<Store> (Details::in_place, begin, end, Details::MakeAllocator<Element> (source));
+}
+
+//
+// Mutable copies:
+//
+
+// Copy the elements into a std::set, which supports Insert(), Erase() and
+// Assign() in O(log N) time per element while keeping ordering comparisons
+// O(1).  Copies that xxx_copy() makes of containers and iterator ranges,
+// whose elements have too many values for a bitset, are sorted vectors, which
+// support the same methods, but Insert() and Erase() take linear time there.
+// Copies of brace-lists, and of elements such as std::uint8_t, which go into
+// inline arrays and bitsets, support none of them.  As with xxx_copy(), C
+// strings are copied as string_views where possible, so that they compare by
+// content.
+
+template<typename Element>
+auto one_mutable(std::initializer_list<Element> const ilist) {
+    using Store = Details::JunctionSortedStore<Details::CopiedElement<Element>>;
+    return One<Store> (ilist.begin(), ilist.end());
+}
+
+template<typename Container>
+auto one_mutable(Container const &container) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*container.begin())>::type>::type;
+    using Store = Details::JunctionSortedStore<Details::CopiedElement<Element>>;
+    return One<Store> (container.begin(), container.end());
+}
+
+template<typename Iterator>
+auto one_mutable(Iterator const begin, Iterator const end) {
+    using Element = typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type;
+    using Store = Details::JunctionSortedStore<Details::CopiedElement<Element>>;
+    return One<Store> (begin, end);
+}
+
+//
+// Versioned containers:
+//
+
+// Piggyback on a container that counts its own mutations -- see
+// JunctionVersionedPiggyBackStore.h -- caching its lowest and highest
+// elements until its version changes:
+
+template<typename Container>
+auto one_versioned(Container const &container) {
+    using Store = Details::JunctionVersionedPiggyBackStore<Container>;
+    return One<Store> (container);
+}
+
+//
+// String views:
+//
+
+// Hold strings as std::string_views, which compare lexicographically with
+// std::strings, std::string_views and C strings alike, without copying the
+// characters.  The views refer to the caller's characters, which must outlive
+// the junction: string literals always do, and a named container of
+// std::strings does as long as it's left alone, but a temporary container
+// doesn't, and so the helpers refuse one.
+
+#if defined P6_HAVE_STRING_VIEW
+inline auto one_sv(std::initializer_list<std::string_view> const ilist) {
+    using Store = Details::InitializerListStore<std::string_view>;
+    return One<Store> (ilist.begin(), ilist.end());
+}
+
+template<typename Container>
+auto one_sv(Container const &container) {
+    using Store = Details::CopyStoreFor<std::string_view>;
+    return One<Store> (container.begin(), container.end());
+}
+
+template<typename Container>
+auto one_sv(Container const &&container) = delete;
+
+template<typename Iterator>
+auto one_sv(Iterator const begin, Iterator const end) {
+    using Store = Details::CopyStoreFor<std::string_view>;
+    return One<Store> (begin, end);
+}
+#endif
+
+
+//
+// Interned strings:
+//
+
+// Intern the strings in an InternTable -- the process-wide one unless you pass
+// your own as the last argument -- and hold them as 32-bit handles, so that
+// comparing the junction with an InternedString from the same table compares
+// integers.  See JunctionInternTable.h.
+
+template<typename Elem>
+auto one_interned(std::initializer_list<Elem> const ilist, InternTable &table = InternTable::Global()) {
+    using Store = Details::JunctionInternStore;
+    return One<Store> (Details::in_place, ilist.begin(), ilist.end(), table);
+}
+
+template<typename Container>
+auto one_interned(Container const &container, InternTable &table = InternTable::Global()) {
+    using Store = Details::JunctionInternStore;
+    return One<Store> (Details::in_place, container.begin(), container.end(), table);
+}
+
+template<typename Iterator>
+auto one_interned(Iterator const begin, Iterator const end, InternTable &table = InternTable::Global()) {
+    using Store = Details::JunctionInternStore;
+    return One<Store> (Details::in_place, begin, end, table);
+}
+
+
+//
+// Projections:
+//
+
+// Pass a pointer to a data member, a pointer to a member function or a lambda
+// after a container or a pair of iterators to build a junction of the values
+// that it picks out of each element, as in any(orders, &Order::price).  See
+// JunctionProjectionStore.h.  As usual, named containers and pairs of iterators
+// are referred to, so that comparisons read the values in place, while
+// temporary containers and xxx_copy() copy only the projected values.
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto one_ref(Container const &container, Projection const &projection) {
+    using Store = Details::JunctionProjectionStore<decltype(std::begin(container)), Projection>;
+    return One<Store> (Details::in_place, std::begin(container), std::end(container), projection);
+}
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto one_copy(Container const &container, Projection const &projection) {
+    using Element = Details::ContainerProjectedElement<Container, Projection>;
+    using Store = Details::CopyStoreFor<Details::CopiedElement<Element>>;
+    auto const begin = Details::MakeProjectingIterator(std::begin(container), projection);
+    auto const end   = Details::MakeProjectingIterator(std::end(container),   projection);
+    return One<Store> (begin, end);
+}
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto one(Container &&container, Projection const &projection) {
+    return one_copy(container, projection);
+}
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto one(Container &container, Projection const &projection) {
+    return one_ref(container, projection);
+}
+
+template<typename Container, typename Projection, typename = Details::ContainerProjectedElement<Container, Projection>>
+auto one(Container const &container, Projection const &projection) {
+    return one_ref(container, projection);
+}
+
+template<typename Iterator, typename Projection, typename = Details::ProjectedElement<Iterator, Projection>>
+auto one_ref(Iterator const begin, Iterator const end, Projection const &projection) {
+    using Store = Details::JunctionProjectionStore<Iterator, Projection>;
+    return One<Store> (Details::in_place, begin, end, projection);
+}
+
+template<typename Iterator, typename Projection, typename = Details::ProjectedElement<Iterator, Projection>>
+auto one_copy(Iterator const begin, Iterator const end, Projection const &projection) {
+    using Element = Details::ProjectedElement<Iterator, Projection>;
+    using Store = Details::CopyStoreFor<Details::CopiedElement<Element>>;
+    return One<Store> (Details::MakeProjectingIterator(begin, projection), Details::MakeProjectingIterator(end, projection));
+}
+
+template<typename Iterator, typename Projection, typename = Details::ProjectedElement<Iterator, Projection>>
+auto one(Iterator const begin, Iterator const end, Projection const &projection) {
+    return one_ref(begin, end, projection);
+}
+
+
+//
+// Columns:
+//
+
+// Refer to a column of a table that's held column-wise -- a pointer, a number
+// of rows and optionally a stride, a P6::Column, or a contiguous container --
+// and scan it in blocks that the compiler can vectorise.  See
+// JunctionColumnStore.h.  Temporary containers are refused, because the
+// junction would outlive them.
+
+template<typename T>
+auto one_column(T const *const data, std::size_t const nr_rows, std::ptrdiff_t const stride = 1) {
+    using Store = Details::JunctionColumnStore<T>;
+    return One<Store> (column(data, nr_rows, stride));
+}
+
+template<typename T>
+auto one_column(Column<T> const column) {
+    using Store = Details::JunctionColumnStore<T>;
+    return One<Store> (column);
+}
+
+template<typename Contiguous>
+auto one_column(Contiguous const &contiguous) {
+    auto const col = column(contiguous);
+    using Store = Details::JunctionColumnStore<typename decltype(col)::value_type>;
+    return One<Store> (col);
+}
+
+template<typename Contiguous>
+auto one_column(Contiguous const &&contiguous) = delete;
+
+// Compare two columns of the same length row by row, returning true if the
+// predicate holds for exactly one row -- as in
+// one_rows(bids, asks, std::less<> ()) -- rather than comparing every value
+// in one with every value in the other, as (one_column(bids) < one_column(asks))
+// would.
+
+template<typename Lhs, typename Rhs, typename Predicate>
+bool one_rows(Lhs const &lhs, Rhs const &rhs, Predicate const &predicate) {
+    return Details::ScanRows(column(lhs), column(rhs), predicate, [] (std::size_t const nr_rows, auto const &row_matches) {
+        return Details::OneRowMatches(nr_rows, row_matches);
+    });
+}
+
+
+//
+// Memory-mapped files:
+//
+
+// Map a file of fixed-width numbers into memory, read-only, rather than reading
+// it: pass the element type explicitly, as in any_mapped<std::uint64_t>(path),
+// and optionally P6::sorted first if the elements are sorted and unique.  See
+// JunctionMappedFileStore.h.  The hint tells the kernel how the pages will be
+// read.
+
+#if defined P6_HAVE_MMAP
+template<typename Element>
+auto one_mapped(std::string const &path, AccessHint const hint = AccessHint::Sequential) {
+    using Store = Details::JunctionMappedFileStore<Element, false>;
+    return One<Store> (Details::in_place, path, hint);
+}
+
+template<typename Element>
+auto one_mapped(SortedTag, std::string const &path, AccessHint const hint = AccessHint::Random) {
+    using Store = Details::JunctionMappedFileStore<Element, true>;
+    return One<Store> (Details::in_place, path, hint);
+}
+#endif
+
+
+//
+// Snapshots:
+//
+
+// Load a file written by P6::Save() into a sorted copy: pass the element type
+// explicitly, as in any_load<std::uint64_t>(path).  See JunctionSnapshot.h.
+// To use the file without reading it, map it with xxx_mapped() instead.
+
+template<typename Element>
+auto one_load(std::string const &path) {
+    using Store = Details::JunctionFlatSortedStore<Element>;
+    return One<Store> (Load<Element> (path));
+}
+
+
+//
+// Constant sets:
+//
+
+// Build a junction of constants at compile time, as in
+// one_constant(2, 3, 5, 7) or one_constant(std::array<int, 4> {...}): its
+// comparisons with single values are constexpr.  See JunctionConstantStore.h.
+
+template<typename T, typename... Ts>
+constexpr auto one_constant(T const first, Ts const ...rest) {
+    using Element = std::common_type_t<T, Ts...>;
+    using Store   = Details::JunctionConstantStore<Element, 1 + sizeof...(Ts)>;
+    return One<Store> (Details::in_place, first, rest...);
+}
+
+template<typename T, std::size_t N>
+constexpr auto one_constant(std::array<T, N> const &array) {
+    using Store = Details::JunctionConstantStore<T, N>;
+    return One<Store> (Details::in_place, array);
+}
+
+
+//
+// Enums:
+//
+
+// Build a junction of enumerators given as template arguments, as in
+// one_enum<State, State::Idle, State::Closed>(), or, with C++17,
+// one_enum<State::Idle, State::Closed>().  Its elements are a bitmask
+// computed at compile time.  See JunctionEnumStore.h.
+
+template<typename E, E... Values>
+constexpr auto one_enum() {
+    using Store = Details::JunctionEnumStore<E, Values...>;
+    return One<Store> (Details::in_place);
+}
+
+#if __cplusplus >= 201703L
+template<auto First, decltype(First)... Rest>
+constexpr auto one_enum() {
+    return one_enum<decltype(First), First, Rest...> ();
+}
+#endif
+
+
+//
+// Shared memory:
+//
+
+// Attach to the latest generation of elements published under a name by
+// P6::Publish(), as a sorted junction: pass the element type explicitly, as
+// in one_shared<std::uint64_t>("/deny-list").  See JunctionSharedStore.h.
+
+#if defined P6_HAVE_MMAP
+template<typename Element>
+auto one_shared(std::string const &name, AccessHint const hint = AccessHint::Random) {
+    using Store = Details::JunctionSharedStore<Element>;
+    return One<Store> (Details::in_place, name, hint);
+}
+#endif
+
 }
 
 #endif
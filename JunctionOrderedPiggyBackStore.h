@@ -0,0 +1,250 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionOrderedPiggyBackStore_h
+#define      P6JunctionOrderedPiggyBackStore_h
+
+// Stores a Junction's elements by reference to a container passed in by the
+// caller, as JunctionPiggyBackStore does, but for containers that keep their
+// elements in ascending order, such as std::set.  Because the container does
+// the sorting for us, we get the optimisations enjoyed by the copying stores
+// without having to make a copy.
+//
+// For std::map and std::multimap, and for anything else with a mapped_type,
+// the junction's elements are the keys.
+
+#include "JunctionPiggyBackStore.h"
+#include "JunctionRange.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <set>
+#include <type_traits>
+#include <utility>
+
+namespace P6 {
+
+// Specialise IsSortedContainer for your own container types, such as flat
+// sets, to tell junctions that a container's iterators visit its elements (or,
+// for maps, its keys) in ascending order.  The iterators must be at least
+// bidirectional.  Duplicate elements are allowed, and they're treated in the
+// same way as duplicates in an unsorted container.
+//
+// Standard containers qualify only if they use std::less, because a
+// std::set<int, std::greater<int>> is sorted in descending order.
+
+template<typename Container>
+struct IsSortedContainer {
+    static bool const value = false;
+};
+
+template<typename Key, typename Less>
+struct IsStandardLess {
+    static bool const value = std::is_same<Less, std::less<Key>>::value or std::is_same<Less, std::less<>>::value;
+};
+
+template<typename Key, typename Less, typename Allocator>
+struct IsSortedContainer<std::set<Key, Less, Allocator>>: IsStandardLess<Key, Less> { };
+
+template<typename Key, typename Less, typename Allocator>
+struct IsSortedContainer<std::multiset<Key, Less, Allocator>>: IsStandardLess<Key, Less> { };
+
+template<typename Key, typename Value, typename Less, typename Allocator>
+struct IsSortedContainer<std::map<Key, Value, Less, Allocator>>: IsStandardLess<Key, Less> { };
+
+template<typename Key, typename Value, typename Less, typename Allocator>
+struct IsSortedContainer<std::multimap<Key, Value, Less, Allocator>>: IsStandardLess<Key, Less> { };
+
+namespace Details {
+
+// gcc-4.9.2 doesn't have std::void_t, which arrived in C++17:
+
+template<typename T>
+struct MakeVoid {
+    using type = void;
+};
+
+template<typename T>
+using VoidT = typename MakeVoid<T>::type;
+
+// Presents a map's iterator as an iterator over its keys:
+
+template<typename MapIterator>
+class KeyIterator {
+    MapIterator it;
+
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type        = typename std::remove_const<decltype(it->first)>::type;
+    using difference_type   = typename std::iterator_traits<MapIterator>::difference_type;
+    using pointer           = value_type const *;
+    using reference         = value_type const &;
+
+    explicit KeyIterator(MapIterator const it): it(it)   { }
+
+    reference operator * () const {
+        return it->first;
+    }
+
+    pointer operator -> () const {
+        return &it->first;
+    }
+
+    KeyIterator &operator ++ () {
+        ++it;
+        return *this;
+    }
+
+    KeyIterator &operator -- () {
+        --it;
+        return *this;
+    }
+
+    KeyIterator operator ++ (int) {
+        return KeyIterator(it++);
+    }
+
+    KeyIterator operator -- (int) {
+        return KeyIterator(it--);
+    }
+
+    bool operator == (KeyIterator const &rhs) const {
+        return it == rhs.it;
+    }
+
+    bool operator != (KeyIterator const &rhs) const {
+        return it != rhs.it;
+    }
+};
+
+// For sets, the elements are their own keys:
+
+template<typename Container, typename = void>
+struct SortedContainerKeys {
+    using Element  = typename Container::value_type;
+    using Iterator = typename Container::const_iterator;
+
+    static Container const &Keys(Container const &container) {
+        return container;
+    }
+};
+
+// For maps, we present only the keys:
+
+template<typename Container>
+struct SortedContainerKeys<Container, VoidT<typename Container::mapped_type>> {
+    using Element  = typename Container::key_type;
+    using Iterator = KeyIterator<typename Container::const_iterator>;
+
+    static JunctionRange<Iterator> Keys(Container const &container) {
+        return {Iterator(container.begin()), Iterator(container.end())};
+    }
+};
+
+template<typename Container>
+class JunctionOrderedPiggyBackStore {
+    using Keys = SortedContainerKeys<Container>;
+
+public:
+    using Element             = typename Keys::Element;
+    static bool const Ordered = true;
+    static bool const Indexed = false;
+
+private:
+    Container const &container;
+
+    typename Keys::Iterator Begin() const {
+        return std::begin(Keys::Keys(container));
+    }
+
+    typename Keys::Iterator End() const {
+        return std::end(Keys::Keys(container));
+    }
+
+protected:
+    JunctionOrderedPiggyBackStore(Container const &container)
+        : container(container)   { }
+
+public:
+    decltype(Keys::Keys(std::declval<Container const &>())) Elements() const {
+        return Keys::Keys(container);
+    }
+
+    bool IsEmpty() const {
+        return container.empty();
+    }
+
+    auto GetSize() const {
+        return container.size();
+    }
+
+    bool HasSecondElement() const {
+        return GetSize() >= 2;
+    }
+
+protected:
+    Element const &FirstElement() const {
+        assert(not IsEmpty());
+        return *Begin();
+    }
+
+    Element const &SecondElement() const {
+        assert(HasSecondElement());
+        return *std::next(Begin());
+    }
+
+    Element const &PenultimateElement() const {
+        assert(HasSecondElement());
+        return *std::prev(End(), 2);
+    }
+
+    Element const &LastElement() const {
+        assert(not IsEmpty());
+        return *std::prev(End());
+    }
+
+    Element const &GetAnyElement() const {
+        return FirstElement();
+    }
+};
+
+// Check a caller's promise that a range is sorted, if asked to:
+
+template<typename Iterator>
+inline void CheckSorted(Iterator const begin, Iterator const end) {
+#if defined P6_CHECK_SORTED
+    assert(std::is_sorted(begin, end));
+#else
+    static_cast<void> (begin);
+    static_cast<void> (end);
+#endif
+}
+
+// Choose how to piggyback on a named container:
+
+template<typename Container>
+using PiggyBackStoreFor = typename std::conditional<
+    IsSortedContainer<Container>::value,
+    JunctionOrderedPiggyBackStore<Container>,
+    JunctionPiggyBackStore<Container>
+>::type;
+
+} }
+
+#endif
@@ -0,0 +1,296 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionPackedStore_h
+#define      P6JunctionPackedStore_h
+
+// Stores a Junction's integer elements sorted, deduplicated and compressed,
+// for long-lived junctions of timestamps, ids and so on, where memory matters
+// more than the last few nanoseconds of lookup time.
+//
+// The elements are cut into blocks of BlockSize.  The first element of each
+// block goes into a small skip index, along with the offset of the block's
+// remaining elements, which are stored as the differences between neighbours,
+// each encoded as a varint: seven bits per byte, with the top bit set on every
+// byte but the last.  Neighbouring timestamps or ids that are close together
+// therefore take one or two bytes each, rather than eight.
+//
+// Looking up a value takes a binary search of the skip index and then a scan
+// of at most one block, so O(log(N / BlockSize) + BlockSize).  The store finds
+// its two lowest and two highest elements when it's built, and so it's
+// Ordered, and ordering comparisons take constant time.
+//
+// The blocks can take their memory from any standard allocator; see
+// JunctionAllocator.h.
+
+#include "JunctionAllocator.h"
+#include "JunctionRange.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace P6 { namespace Details {
+
+template<typename T, typename Alloc = std::allocator<T>, std::size_t BlockSize = 128>
+class JunctionPackedStore {
+public:
+    using Element             = T;
+    using Allocator           = Alloc;
+    static bool const Ordered = true;
+    static bool const Indexed = true;
+
+    static_assert(std::is_integral<T>::value and not std::is_same<T, bool>::value, "A packed store holds integers other than bool");
+    static_assert(BlockSize != 0, "Blocks must hold at least one element");
+
+private:
+    using Key      = std::uint64_t;
+    using Unsigned = typename std::make_unsigned<T>::type;
+
+    template<typename U>
+    using Vector = std::vector<U, ReboundAllocator<Allocator, U>>;
+
+    // Flipping the sign bit of a signed element maps it to an unsigned key
+    // with the same order:
+    static Unsigned constexpr SignFlip = std::is_signed<T>::value? Unsigned {1} << (std::numeric_limits<Unsigned>::digits - 1): 0;
+
+    static Key KeyOf(Element const elem) {
+        return static_cast<Unsigned> (static_cast<Unsigned> (elem) ^ SignFlip);
+    }
+
+    static Element ElementAt(Key const key) {
+        return static_cast<Element> (static_cast<Unsigned> (static_cast<Unsigned> (key) ^ SignFlip));
+    }
+
+    static void AppendVarint(Vector<std::uint8_t> &bytes, Key value) {
+        while (value >= 0x80) {
+            bytes.push_back(static_cast<std::uint8_t> (value | 0x80));
+            value >>= 7;
+        }
+
+        bytes.push_back(static_cast<std::uint8_t> (value));
+    }
+
+    static Key ReadVarint(std::uint8_t const *&p) {
+        Key value = 0;
+        unsigned shift = 0;
+        while (*p & 0x80) {
+            value |= Key {*p++ & 0x7Fu} << shift;
+            shift += 7;
+        }
+
+        return value | Key {*p++} << shift;
+    }
+
+    Vector<Key>           block_firsts;     // The first key in each block
+    Vector<std::size_t>   block_offsets;    // Where each block's deltas start in `bytes'
+    Vector<std::uint8_t>  bytes;            // Varint-encoded deltas
+    std::size_t                size = 0;
+
+    // The two lowest and two highest elements, for the Ordered comparisons:
+    Element first {}, second {}, penultimate {}, last {};
+
+    template<typename Iterator>
+    void Build(Iterator const begin, Iterator const end) {
+        Vector<Key> keys(bytes.get_allocator());
+        for (auto it = begin;  it != end;  ++it)
+            keys.push_back(KeyOf(*it));
+
+        if (not std::is_sorted(keys.begin(), keys.end()))
+            std::sort(keys.begin(), keys.end());
+
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        size = keys.size();
+        if (size == 0)
+            return;
+
+        auto const nr_blocks = (size + BlockSize - 1) / BlockSize;
+        block_firsts.reserve(nr_blocks);
+        block_offsets.reserve(nr_blocks);
+        for (std::size_t i = 0;  i != size;  ++i)
+            if (i % BlockSize == 0) {
+                block_firsts.push_back(keys[i]);
+                block_offsets.push_back(bytes.size());
+            }
+            else {
+                AppendVarint(bytes, keys[i] - keys[i - 1]);
+            }
+
+        bytes.shrink_to_fit();
+
+        first = ElementAt(keys.front());
+        last  = ElementAt(keys.back());
+        if (size >= 2) {
+            second      = ElementAt(keys[1]);
+            penultimate = ElementAt(keys[size - 2]);
+        }
+    }
+
+public:
+    // Decodes the elements in ascending order, and so returns them by value.
+    class Iterator {
+        JunctionPackedStore const *store;
+        std::size_t                index;
+        std::uint8_t const        *next_delta;
+        Key                        key;
+
+        void EnterBlock() {
+            if (index == store->size)
+                return;
+
+            auto const block = index / BlockSize;
+            key        = store->block_firsts[block];
+            next_delta = store->bytes.data() + store->block_offsets[block];
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Element;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Element const *;
+        using reference         = Element;
+
+        Iterator(JunctionPackedStore const *const store, std::size_t const index)
+            : store(store),
+              index(index),
+              next_delta(nullptr),
+              key(0) {
+            EnterBlock();
+        }
+
+        Element operator * () const {
+            return ElementAt(key);
+        }
+
+        Iterator &operator ++ () {
+            if (++index == store->size)
+                return *this;
+
+            if (index % BlockSize == 0)
+                EnterBlock();
+            else
+                key += ReadVarint(next_delta);
+
+            return *this;
+        }
+
+        Iterator operator ++ (int) {
+            auto const old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator == (Iterator const &rhs) const {
+            return index == rhs.index;
+        }
+
+        bool operator != (Iterator const &rhs) const {
+            return index != rhs.index;
+        }
+    };
+
+    JunctionPackedStore(std::initializer_list<Element> const ilist, Allocator const &allocator = Allocator())
+        : block_firsts(allocator),
+          block_offsets(allocator),
+          bytes(allocator) {
+        Build(ilist.begin(), ilist.end());
+    }
+
+    template<typename It>
+    JunctionPackedStore(It const begin, It const end, Allocator const &allocator = Allocator())
+        : block_firsts(allocator),
+          block_offsets(allocator),
+          bytes(allocator) {
+        Build(begin, end);
+    }
+
+    JunctionPackedStore(std::vector<Element> const &elements)
+        : JunctionPackedStore(elements.begin(), elements.end())   { }
+
+    JunctionRange<Iterator> Elements() const {
+        return {Iterator(this, 0), Iterator(this, size)};
+    }
+
+    Allocator GetAllocator() const {
+        return Allocator(bytes.get_allocator());
+    }
+
+    bool IsEmpty() const {
+        return size == 0;
+    }
+
+    auto GetSize() const {
+        return size;
+    }
+
+    bool HasSecondElement() const {
+        return GetSize() >= 2;
+    }
+
+    bool Contains(Element const &value) const {
+        auto const wanted = KeyOf(value);
+
+        // Find the last block starting at or below the value:
+        auto const after = std::upper_bound(block_firsts.begin(), block_firsts.end(), wanted);
+        if (after == block_firsts.begin())
+            return false;
+
+        auto const block = static_cast<std::size_t> (after - block_firsts.begin()) - 1;
+        auto key = block_firsts[block];
+        auto p   = bytes.data() + block_offsets[block];
+        auto const nr_deltas = std::min(BlockSize, size - block * BlockSize) - 1;
+        for (std::size_t i = 0;  i != nr_deltas and key < wanted;  ++i)
+            key += ReadVarint(p);
+
+        return key == wanted;
+    }
+
+protected:
+    Element const &FirstElement() const {
+        assert(not IsEmpty());
+        return first;
+    }
+
+    Element const &SecondElement() const {
+        assert(HasSecondElement());
+        return second;
+    }
+
+    Element const &PenultimateElement() const {
+        assert(HasSecondElement());
+        return penultimate;
+    }
+
+    Element const &LastElement() const {
+        assert(not IsEmpty());
+        return last;
+    }
+
+    Element const &GetAnyElement() const {
+        return FirstElement();
+    }
+};
+
+} }
+
+#endif
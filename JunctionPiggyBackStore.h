@@ -27,6 +27,7 @@ class JunctionPiggyBackStore {
 public:
     using Element             = typename Container::value_type;
     static bool const Ordered = false;
+    static bool const Indexed = false;
 
 private:
     Container const &container;
@@ -0,0 +1,165 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionProjectionStore_h
+#define      P6JunctionProjectionStore_h
+
+// Stores a Junction's elements by reference to a range of objects, such as the
+// orders in a std::vector<Order>, together with a projection that picks a value
+// out of each one: a pointer to a data member, as in &Order::price, a pointer
+// to a member function that takes no arguments, or anything callable with an
+// element.  Comparisons apply the projection as they scan, and so
+// any(orders, &Order::price) reads each price in place rather than copying the
+// prices into a vector of their own.
+//
+// As with JunctionIteratorStore, the caller must keep the objects alive, and
+// the iterators valid, for as long as the junction is in use.  Helper
+// functions that copy the projected values use ProjectingIterator to feed them
+// straight into an ordinary copying store, which then holds only those values.
+
+#include "JunctionRange.h"
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace P6 { namespace Details {
+
+// Apply a projection to an object:
+
+template<typename Object, typename Class, typename Member>
+auto Project(Member Class::*const member, Object const &object)
+    -> typename std::enable_if<not std::is_function<Member>::value, decltype(object.*member)>::type {
+    return object.*member;
+}
+
+template<typename Object, typename Class, typename Member>
+auto Project(Member Class::*const method, Object const &object)
+    -> typename std::enable_if<std::is_function<Member>::value, decltype((object.*method)())>::type {
+    return (object.*method)();
+}
+
+template<typename Object, typename Projection>
+auto Project(Projection const &projection, Object const &object)
+    -> typename std::enable_if<not std::is_member_pointer<Projection>::value, decltype(projection(object))>::type {
+    return projection(object);
+}
+
+// The type of value that a projection picks out of the elements of a range;
+// the helper functions use it to ignore projections that don't apply, so that
+// they don't compete with the overloads that take a pair of iterators or
+// P6::sorted:
+
+template<typename Iterator, typename Projection>
+using ProjectedReference = decltype(Project(std::declval<Projection const &> (), *std::declval<Iterator> ()));
+
+template<typename Iterator, typename Projection>
+using ProjectedElement = typename std::decay<ProjectedReference<Iterator, Projection>>::type;
+
+template<typename Container, typename Projection>
+using ContainerProjectedElement = ProjectedElement<decltype(std::begin(std::declval<Container const &> ())), Projection>;
+
+// Wraps an iterator, projecting each element as it's read.  A pointer to a
+// data member yields a reference to the member, and so nothing is copied.
+template<typename Iterator, typename Projection>
+class ProjectingIterator {
+    Iterator          it;
+    Projection const *projection;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = ProjectedElement<Iterator, Projection>;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = value_type const *;
+    using reference         = ProjectedReference<Iterator, Projection>;
+
+    ProjectingIterator(Iterator const it, Projection const &projection)
+        : it(it),
+          projection(&projection)   { }
+
+    reference operator * () const {
+        return Project(*projection, *it);
+    }
+
+    ProjectingIterator &operator ++ () {
+        ++it;
+        return *this;
+    }
+
+    ProjectingIterator operator ++ (int) {
+        auto const old = *this;
+        ++it;
+        return old;
+    }
+
+    bool operator == (ProjectingIterator const &rhs) const {
+        return it == rhs.it;
+    }
+
+    bool operator != (ProjectingIterator const &rhs) const {
+        return it != rhs.it;
+    }
+};
+
+template<typename Iterator, typename Projection>
+ProjectingIterator<Iterator, Projection> MakeProjectingIterator(Iterator const it, Projection const &projection) {
+    return ProjectingIterator<Iterator, Projection> (it, projection);
+}
+
+template<typename Iterator, typename Projection>
+class JunctionProjectionStore {
+public:
+    using Element             = ProjectedElement<Iterator, Projection>;
+    static bool const Ordered = false;
+    static bool const Indexed = false;
+
+private:
+    using Projecting = ProjectingIterator<Iterator, Projection>;
+
+    Iterator   begin;
+    Iterator   end;
+    Projection projection;
+
+protected:
+    JunctionProjectionStore(Iterator const begin, Iterator const end, Projection const &projection)
+        : begin(begin),
+          end(end),
+          projection(projection)   { }
+
+    Element GetAnyElement() const {
+        assert(not IsEmpty());
+        return Project(projection, *begin);
+    }
+
+public:
+    JunctionRange<Projecting> Elements() const {
+        return {Projecting(begin, projection), Projecting(end, projection)};
+    }
+
+    bool IsEmpty() const {
+        return begin == end;
+    }
+
+    auto GetSize() const {
+        return static_cast<std::size_t> (std::distance(begin, end));
+    }
+};
+
+} }
+
+#endif
@@ -0,0 +1,61 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionRange_h
+#define      P6JunctionRange_h
+
+// A lightweight, non-owning view of a pair of iterators, which stores can
+// return from Elements() when they don't have a real container to hand back.
+// It supports just enough of the container interface for range-based for
+// loops and for JunctionPiggyBackStore-style emptiness checks.
+
+#include <cstddef>
+#include <iterator>
+
+namespace P6 { namespace Details {
+
+template<typename Iterator>
+class JunctionRange {
+    Iterator first, last;
+
+public:
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+    using iterator   = Iterator;
+
+    JunctionRange(Iterator const first, Iterator const last)
+        : first(first),
+          last(last)   { }
+
+    Iterator begin() const {
+        return first;
+    }
+
+    Iterator end() const {
+        return last;
+    }
+
+    bool empty() const {
+        return first == last;
+    }
+
+    std::size_t size() const {
+        return static_cast<std::size_t> (std::distance(first, last));
+    }
+};
+
+} }
+
+#endif
@@ -75,32 +75,32 @@ struct WhereOnlySecondIsAJunction: std::enable_if<IsOnlySecondAJunction<Arg1, Ar
 // junction comparisons.
 
 template<typename V, typename J>
-typename Details::WhereOnlySecondIsAJunction<V, J, bool>::type operator < (V const &v, J const &j) {
+constexpr typename Details::WhereOnlySecondIsAJunction<V, J, bool>::type operator < (V const &v, J const &j) {
     return j > v;
 }
 
 template<typename V, typename J>
-typename Details::WhereOnlySecondIsAJunction<V, J, bool>::type operator <= (V const &v, J const &j) {
+constexpr typename Details::WhereOnlySecondIsAJunction<V, J, bool>::type operator <= (V const &v, J const &j) {
     return j >= v;
 }
 
 template<typename V, typename J>
-typename Details::WhereOnlySecondIsAJunction<V, J, bool>::type operator == (V const &v, J const &j) {
+constexpr typename Details::WhereOnlySecondIsAJunction<V, J, bool>::type operator == (V const &v, J const &j) {
     return j == v;
 }
 
 template<typename V, typename J>
-typename Details::WhereOnlySecondIsAJunction<V, J, bool>::type operator >= (V const &v, J const &j) {
+constexpr typename Details::WhereOnlySecondIsAJunction<V, J, bool>::type operator >= (V const &v, J const &j) {
     return j <= v;
 }
 
 template<typename V, typename J>
-typename Details::WhereOnlySecondIsAJunction<V, J, bool>::type operator > (V const &v, J const &j) {
+constexpr typename Details::WhereOnlySecondIsAJunction<V, J, bool>::type operator > (V const &v, J const &j) {
     return j < v;
 }
 
 template<typename V, typename J>
-typename Details::WhereOnlySecondIsAJunction<V, J, bool>::type operator != (V const &v, J const &j) {
+constexpr typename Details::WhereOnlySecondIsAJunction<V, J, bool>::type operator != (V const &v, J const &j) {
     return j != v;
 }
 
@@ -0,0 +1,403 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionRoaringStore_h
+#define      P6JunctionRoaringStore_h
+
+// Stores a Junction's elements as a compressed bitmap, for large junctions of
+// integers of up to 32 bits, such as millions of user ids.
+//
+// As in a Roaring bitmap, the domain is cut into blocks of 65,536 values, and
+// only the blocks that hold elements are kept.  Each block picks whichever of
+// three containers is smallest for its elements:
+//
+//  - an array:  a sorted vector of the low 16 bits of each element, taking
+//               two bytes per element;
+//  - a bitmap:  one bit for each of the 65,536 values, taking 8 KiB;
+//  - runs:      a sorted vector of (start, length - 1) pairs, taking four
+//               bytes for each run of consecutive values.
+//
+// A dense junction therefore takes at most a little over one bit per possible
+// value, and a sparse one a little over two bytes per element, compared with
+// roughly 40 bytes per element in a std::set.  Looking up a value takes a
+// binary search among the blocks and then one in the block's container, or a
+// single bit test in a bitmap.  The elements are visited in ascending order,
+// and so the store is Ordered; like JunctionBitsetStore, it finds the two
+// lowest and two highest elements when it's built, so that ordering
+// comparisons take constant time.
+//
+// The blocks and their containers can take their memory from any standard
+// allocator; see JunctionAllocator.h.
+
+#include "JunctionAllocator.h"
+#include "JunctionBitsetStore.h"
+#include "JunctionRange.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace P6 { namespace Details {
+
+template<typename T, typename Alloc = std::allocator<T>>
+class JunctionRoaringStore {
+public:
+    using Element             = T;
+    using Allocator           = Alloc;
+    static bool const Ordered = true;
+    static bool const Indexed = true;
+
+    static_assert(std::is_integral<T>::value and sizeof(T) <= 4, "A roaring store holds integers of up to 32 bits");
+
+private:
+    using Word = std::uint64_t;
+    static unsigned constexpr BitsPerWord     = 64;
+    static std::size_t constexpr BlockSize    = 1 << 16;
+    static std::size_t constexpr WordsInBlock = BlockSize / BitsPerWord;
+
+    template<typename U>
+    using Vector = std::vector<U, ReboundAllocator<Allocator, U>>;
+
+    // Elements are shifted so that the lowest value of T becomes zero, which
+    // preserves their order:
+    static long long constexpr Lowest = std::numeric_limits<T>::min();
+
+    static std::uint32_t KeyOf(Element const elem) {
+        return static_cast<std::uint32_t> (static_cast<long long> (elem) - Lowest);
+    }
+
+    static Element ElementAt(std::uint32_t const key) {
+        return static_cast<Element> (static_cast<long long> (key) + Lowest);
+    }
+
+    enum class Kind: std::uint8_t {Array, Bitmap, Runs};
+
+    struct Container {
+        Kind                  kind;
+        Vector<std::uint16_t> values;    // Array: low bits; Runs: (start, length - 1) pairs
+        Vector<Word>          bits;      // Bitmap only
+
+        explicit Container(Allocator const &allocator)
+            : kind(Kind::Array),
+              values(allocator),
+              bits(allocator)   { }
+
+        bool Contains(std::uint16_t const low) const {
+            switch (kind) {
+            case Kind::Array:
+                return std::binary_search(values.begin(), values.end(), low);
+            case Kind::Bitmap:
+                return (bits[low / BitsPerWord] >> (low % BitsPerWord)) & 1;
+            case Kind::Runs:
+                break;
+            }
+
+            // Find the last run starting at or below `low':
+            std::size_t lo = 0, hi = values.size() / 2;
+            while (lo < hi) {
+                auto const mid = (lo + hi) / 2;
+                if (values[2 * mid] <= low)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+
+            return lo != 0 and low - values[2 * (lo - 1)] <= values[2 * (lo - 1) + 1];
+        }
+
+        // Find the lowest set bit at or above `low', or return BlockSize:
+        std::size_t NextSetBit(std::size_t const low) const {
+            if (low >= BlockSize)
+                return BlockSize;
+
+            auto w    = low / BitsPerWord;
+            auto word = bits[w] & (~Word {0} << (low % BitsPerWord));
+            while (word == 0) {
+                if (++w == WordsInBlock)
+                    return BlockSize;
+
+                word = bits[w];
+            }
+
+            return w * BitsPerWord + CountTrailingZeros(word);
+        }
+    };
+
+    Vector<std::uint16_t> block_keys;    // The high 16 bits of each block, ascending
+    Vector<Container>     containers;    // One per block key
+    std::size_t                size = 0;
+
+    // The two lowest and two highest elements, for the Ordered comparisons:
+    Element first {}, second {}, penultimate {}, last {};
+
+    // Store the low 16 bits of a block's elements, which are sorted and
+    // unique, in whichever container is smallest:
+    static Container MakeContainer(std::uint32_t const *const begin, std::uint32_t const *const end, Allocator const &allocator) {
+        auto const nr_values = static_cast<std::size_t> (end - begin);
+        std::size_t nr_runs  = 1;
+        for (auto p = begin + 1;  p != end;  ++p)
+            nr_runs += *p != p[-1] + 1;
+
+        // Sizes in bytes:
+        auto const array_size  = nr_values * sizeof(std::uint16_t);
+        auto const bitmap_size = WordsInBlock * sizeof(Word);
+        auto const runs_size   = nr_runs * 2 * sizeof(std::uint16_t);
+
+        Container container(allocator);
+        if (runs_size < array_size and runs_size < bitmap_size) {
+            container.kind = Kind::Runs;
+            container.values.reserve(nr_runs * 2);
+            for (auto p = begin;  p != end; ) {
+                auto run_end = p + 1;
+                while (run_end != end and *run_end == run_end[-1] + 1)
+                    ++run_end;
+
+                container.values.push_back(static_cast<std::uint16_t> (*p));
+                container.values.push_back(static_cast<std::uint16_t> (run_end - p - 1));
+                p = run_end;
+            }
+        }
+        else if (array_size <= bitmap_size) {
+            container.kind = Kind::Array;
+            container.values.reserve(nr_values);
+            for (auto p = begin;  p != end;  ++p)
+                container.values.push_back(static_cast<std::uint16_t> (*p));
+        }
+        else {
+            container.kind = Kind::Bitmap;
+            container.bits.assign(WordsInBlock, 0);
+            for (auto p = begin;  p != end;  ++p) {
+                auto const low = *p & 0xFFFF;
+                container.bits[low / BitsPerWord] |= Word {1} << (low % BitsPerWord);
+            }
+        }
+
+        return container;
+    }
+
+    template<typename Iterator>
+    void Build(Iterator const begin, Iterator const end) {
+        auto const allocator = GetAllocator();
+        Vector<std::uint32_t> keys(allocator);
+        for (auto it = begin;  it != end;  ++it)
+            keys.push_back(KeyOf(*it));
+
+        if (not std::is_sorted(keys.begin(), keys.end()))
+            std::sort(keys.begin(), keys.end());
+
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        size = keys.size();
+        if (size == 0)
+            return;
+
+        auto const data = keys.data();
+        for (std::size_t i = 0;  i != size; ) {
+            auto const high = keys[i] >> 16;
+            auto j = i;
+            while (j != size and keys[j] >> 16 == high)
+                ++j;
+
+            block_keys.push_back(static_cast<std::uint16_t> (high));
+            containers.push_back(MakeContainer(data + i, data + j, allocator));
+            i = j;
+        }
+
+        first = ElementAt(keys.front());
+        last  = ElementAt(keys.back());
+        if (size >= 2) {
+            second      = ElementAt(keys[1]);
+            penultimate = ElementAt(keys[size - 2]);
+        }
+    }
+
+public:
+    // Visits the elements in ascending order, computing each from its block
+    // key and its position in the block's container, and so the iterator
+    // returns them by value.
+    class Iterator {
+        JunctionRoaringStore const *store;
+        std::size_t block;    // Index into block_keys and containers
+        std::size_t index;    // Index into an array or run container
+        std::size_t low;      // The low 16 bits of the current element
+
+        Container const &GetContainer() const {
+            return store->containers[block];
+        }
+
+        // Move to the first element of the current block, if there is one:
+        void EnterBlock() {
+            index = 0;
+            low   = 0;
+            if (block == store->containers.size())
+                return;
+
+            auto const &container = GetContainer();
+            switch (container.kind) {
+            case Kind::Array:
+            case Kind::Runs:
+                low = container.values[0];
+                break;
+            case Kind::Bitmap:
+                low = container.NextSetBit(0);
+                break;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Element;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Element const *;
+        using reference         = Element;
+
+        Iterator(JunctionRoaringStore const *const store, std::size_t const block)
+            : store(store),
+              block(block),
+              index(0),
+              low(0) {
+            EnterBlock();
+        }
+
+        Element operator * () const {
+            return ElementAt(static_cast<std::uint32_t> (store->block_keys[block]) << 16 | low);
+        }
+
+        Iterator &operator ++ () {
+            auto const &container = GetContainer();
+            bool at_end = false;
+            switch (container.kind) {
+            case Kind::Array:
+                at_end = ++index == container.values.size();
+                if (not at_end)
+                    low = container.values[index];
+                break;
+            case Kind::Bitmap:
+                low = container.NextSetBit(low + 1);
+                at_end = low == BlockSize;
+                break;
+            case Kind::Runs:
+                if (low != container.values[2 * index] + container.values[2 * index + 1])
+                    ++low;
+                else if (not(at_end = (index += 1) * 2 == container.values.size()))
+                    low = container.values[2 * index];
+                break;
+            }
+
+            if (at_end) {
+                ++block;
+                EnterBlock();
+            }
+
+            return *this;
+        }
+
+        Iterator operator ++ (int) {
+            auto const old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator == (Iterator const &rhs) const {
+            return block == rhs.block and index == rhs.index and low == rhs.low;
+        }
+
+        bool operator != (Iterator const &rhs) const {
+            return not(*this == rhs);
+        }
+    };
+
+    JunctionRoaringStore(std::initializer_list<Element> const ilist, Allocator const &allocator = Allocator())
+        : block_keys(allocator),
+          containers(allocator) {
+        Build(ilist.begin(), ilist.end());
+    }
+
+    template<typename It>
+    JunctionRoaringStore(It const begin, It const end, Allocator const &allocator = Allocator())
+        : block_keys(allocator),
+          containers(allocator) {
+        Build(begin, end);
+    }
+
+    JunctionRoaringStore(std::vector<Element> const &elements)
+        : JunctionRoaringStore(elements.begin(), elements.end())   { }
+
+    JunctionRange<Iterator> Elements() const {
+        return {Iterator(this, 0), Iterator(this, containers.size())};
+    }
+
+    Allocator GetAllocator() const {
+        return Allocator(block_keys.get_allocator());
+    }
+
+    bool IsEmpty() const {
+        return size == 0;
+    }
+
+    auto GetSize() const {
+        return size;
+    }
+
+    bool HasSecondElement() const {
+        return GetSize() >= 2;
+    }
+
+    bool Contains(Element const &value) const {
+        auto const key  = KeyOf(value);
+        auto const high = static_cast<std::uint16_t> (key >> 16);
+        auto const it   = std::lower_bound(block_keys.begin(), block_keys.end(), high);
+        if (it == block_keys.end() or *it != high)
+            return false;
+
+        return containers[it - block_keys.begin()].Contains(static_cast<std::uint16_t> (key));
+    }
+
+protected:
+    Element const &FirstElement() const {
+        assert(not IsEmpty());
+        return first;
+    }
+
+    Element const &SecondElement() const {
+        assert(HasSecondElement());
+        return second;
+    }
+
+    Element const &PenultimateElement() const {
+        assert(HasSecondElement());
+        return penultimate;
+    }
+
+    Element const &LastElement() const {
+        assert(not IsEmpty());
+        return last;
+    }
+
+    Element const &GetAnyElement() const {
+        return FirstElement();
+    }
+};
+
+} }
+
+#endif
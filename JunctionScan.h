@@ -0,0 +1,62 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionScan_h
+#define      P6JunctionScan_h
+
+// Junctions that can't answer a comparison from their lowest and highest
+// elements scan them all, stopping as soon as the answer is known.  These are
+// the scans; stores whose elements lie in memory at regular intervals, such as
+// JunctionColumnStore, overload them with scans that the compiler can turn
+// into vector instructions.
+
+namespace P6 { namespace Details {
+
+// True if the lambda returns true for every element:
+template<typename Elements, typename Lambda>
+bool AllMatch(Elements const &elements, Lambda const &lambda) {
+    for (auto const &elem: elements)
+        if (not(lambda(elem)))
+            return false;
+
+    return true;
+}
+
+// True if the lambda returns true for at least one element:
+template<typename Elements, typename Lambda>
+bool AnyMatch(Elements const &elements, Lambda const &lambda) {
+    for (auto const &elem: elements)
+        if (lambda(elem))
+            return true;
+
+    return false;
+}
+
+// True if the lambda returns true for exactly one element:
+template<typename Elements, typename Lambda>
+bool OneMatches(Elements const &elements, Lambda const &lambda) {
+    unsigned matches {0};
+    for (auto const &elem: elements)
+        if (lambda(elem))
+            if (++matches > 1)
+                return false;
+
+    return matches == 1;
+}
+
+} }
+
+#endif
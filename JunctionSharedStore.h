@@ -0,0 +1,320 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionSharedStore_h
+#define      P6JunctionSharedStore_h
+
+// Stores a Junction's elements in POSIX shared memory, so that many processes
+// on one host can query one copy of a large junction of numbers, such as a
+// deny-list, instead of each building its own.  A loader process publishes
+// the elements of any junction under a name:
+//
+//     P6::Publish(any_copy(ids), "/deny-list");
+//
+// and each worker attaches to them, read-only, as a sorted junction:
+//
+//     auto deny = any_shared<std::uint64_t> ("/deny-list");
+//     if (deny == id)
+//         ....
+//
+// Publishing the same name again makes a new generation of the elements.  The
+// workers keep using the generation they attached to until they choose to
+// move on, which they can do without waiting for anyone:
+//
+//     if (not deny.IsCurrent())
+//         deny = any_shared<std::uint64_t> ("/deny-list");
+//
+// Each generation lives in a shared-memory object of its own, whose name is
+// the published name followed by a dot and the generation number, laid out
+// like a file written by P6::Save(), with an index.  Another, tiny, object
+// under the published name holds the current generation number, which the
+// loader bumps atomically once the new generation is complete.  It then
+// removes the previous generation's name; workers that have already mapped
+// that generation keep it until they let go of it.  A worker that tries to
+// attach to a generation just as it's replaced tries again with the next.
+//
+// Unpublishing a name marks its control object retired before removing it,
+// so that junctions attached to it stop being current, and attach afresh to
+// whatever is published under the name next.
+//
+// Only one process at a time should publish under a given name.  Names start
+// with a slash and contain no other, as shm_open() requires.  Failing to
+// create, open or map an object throws std::system_error, and attaching to a
+// name under which nothing has been published throws std::runtime_error.
+// Some older C libraries need -lrt for shm_open().
+
+#include "JunctionMappedFileStore.h"
+
+#if defined P6_HAVE_MMAP
+
+#include "Junction.h"
+#include "JunctionSnapshot.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace P6 { namespace Details {
+
+// The object under the published name.  Readers map it read-only and only
+// ever load the generation, and so the atomic must be lock-free, which also
+// makes it safe to share between processes.
+struct SharedControlBlock {
+    // The generation of a control object that's been unpublished:
+    static std::uint64_t const Retired = UINT64_MAX;
+
+    char                       magic[8];
+    std::atomic<std::uint64_t> generation;
+
+    static char const *Magic() {
+        return "P6SHARE";
+    }
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Shared junctions need lock-free 64-bit atomics");
+
+[[noreturn]] inline void FailShared(std::string const &what, std::string const &name) {
+    throw std::system_error(errno, std::generic_category(), what + ' ' + name);
+}
+
+inline std::string SharedGenerationName(std::string const &name, std::uint64_t const generation) {
+    return name + '.' + std::to_string(generation);
+}
+
+// Closes a descriptor when it goes out of scope:
+class SharedDescriptor {
+    int fd;
+
+public:
+    explicit SharedDescriptor(int const fd): fd(fd)   { }
+
+    SharedDescriptor(SharedDescriptor const &) = delete;
+    SharedDescriptor &operator = (SharedDescriptor const &) = delete;
+
+    ~SharedDescriptor() {
+        if (fd >= 0)
+            ::close(fd);
+    }
+
+    int Get() const {
+        return fd;
+    }
+};
+
+// A writable mapping, for the loader, unmapped when it goes out of scope:
+class SharedWritableMapping {
+    void        *address;
+    std::size_t  length;
+
+public:
+    SharedWritableMapping(int const fd, std::size_t const length, std::string const &name)
+        : address(::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)),
+          length(length) {
+        if (address == MAP_FAILED)
+            FailShared("Can't map shared memory", name);
+    }
+
+    SharedWritableMapping(SharedWritableMapping const &) = delete;
+    SharedWritableMapping &operator = (SharedWritableMapping const &) = delete;
+
+    ~SharedWritableMapping() {
+        ::munmap(address, length);
+    }
+
+    void *Get() const {
+        return address;
+    }
+};
+
+// A read-only mapping of the control block.  Copies of a junction share it,
+// but every any_shared() call and the like maps it afresh, so that a junction
+// attached after the name is unpublished and published again sees the new
+// control object:
+class SharedControl {
+    FileMapping mapping;
+
+    static int Open(std::string const &name) {
+        int const fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+            FailShared("Can't open shared memory", name);
+
+        return fd;
+    }
+
+public:
+    SharedControl(std::string const &name, int const fd)
+        : mapping(fd, name, AccessHint::Normal) {
+        if (mapping.GetLength() < sizeof(SharedControlBlock) or
+            std::memcmp(mapping.GetBytes(), SharedControlBlock::Magic(), sizeof SharedControlBlock::magic) != 0)
+            throw std::runtime_error(name + ": nothing has been published");
+    }
+
+    static std::shared_ptr<SharedControl const> Attach(std::string const &name) {
+        SharedDescriptor const fd(Open(name));
+        return std::make_shared<SharedControl> (name, fd.Get());
+    }
+
+    std::uint64_t GetGeneration() const {
+        auto const block = reinterpret_cast<SharedControlBlock const *> (mapping.GetBytes());
+        return block->generation.load(std::memory_order_acquire);
+    }
+};
+
+template<typename T>
+class JunctionSharedStore: public JunctionMappedFileStore<T, true> {
+    using Base = JunctionMappedFileStore<T, true>;
+
+    struct Attachment {
+        std::shared_ptr<MappedElements<T> const> file;
+        std::uint64_t                            generation;
+    };
+
+    std::shared_ptr<SharedControl const> control;
+    std::uint64_t                        generation;
+
+    // Map the current generation, trying again if it's replaced between
+    // reading its number and opening it:
+    static Attachment MapCurrent(SharedControl const &control, std::string const &name, AccessHint const hint) {
+        for (;;) {
+            auto const generation = control.GetGeneration();
+            if (generation == 0 or generation == SharedControlBlock::Retired)
+                throw std::runtime_error(name + ": nothing has been published");
+
+            auto const object = SharedGenerationName(name, generation);
+            SharedDescriptor const fd(::shm_open(object.c_str(), O_RDONLY, 0));
+            if (fd.Get() >= 0)
+                return {std::make_shared<MappedElements<T>> (fd.Get(), object, hint), generation};
+
+            if (errno != ENOENT or control.GetGeneration() == generation)
+                FailShared("Can't open shared memory", object);
+        }
+    }
+
+    JunctionSharedStore(Attachment attachment, std::shared_ptr<SharedControl const> const &control, std::string const &name)
+        : Base(std::move(attachment.file), name),
+          control(control),
+          generation(attachment.generation)   { }
+
+    JunctionSharedStore(std::shared_ptr<SharedControl const> const &control, std::string const &name, AccessHint const hint)
+        : JunctionSharedStore(MapCurrent(*control, name, hint), control, name)   { }
+
+public:
+    JunctionSharedStore(std::string const &name, AccessHint const hint)
+        : JunctionSharedStore(SharedControl::Attach(name), name, hint)   { }
+
+    // Which generation of the elements this junction holds:
+    std::uint64_t GetGeneration() const {
+        return generation;
+    }
+
+    // False once a newer generation has been published, or the name has been
+    // unpublished:
+    bool IsCurrent() const {
+        return control->GetGeneration() == generation;
+    }
+};
+
+} // Out of namespace Details
+
+// Publish the elements of any junction of numbers, sorted and without
+// duplicates, as a new generation under the given name, and return its
+// number.  Junctions already attached under the name are unaffected.
+template<typename Store>
+std::uint64_t Publish(Junction<Store> const &junction, std::string const &name) {
+    using Element = typename Store::Element;
+    Details::SnapshotContents<Element> const contents(junction, true);
+
+    Details::SharedDescriptor const control_fd(::shm_open(name.c_str(), O_RDWR | O_CREAT, 0644));
+    if (control_fd.Get() < 0)
+        Details::FailShared("Can't create shared memory", name);
+
+    // A new object is all zeros, which is a valid atomic of zero, meaning that
+    // nothing has been published yet:
+    if (::ftruncate(control_fd.Get(), sizeof(Details::SharedControlBlock)) != 0)
+        Details::FailShared("Can't size shared memory", name);
+
+    Details::SharedWritableMapping const control_mapping(control_fd.Get(), sizeof(Details::SharedControlBlock), name);
+    auto const control = static_cast<Details::SharedControlBlock *> (control_mapping.Get());
+
+    auto const previous   = control->generation.load(std::memory_order_relaxed);
+    auto const generation = previous + 1;
+    auto const object     = Details::SharedGenerationName(name, generation);
+    try {
+        Details::SharedDescriptor const fd(::shm_open(object.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644));
+        if (fd.Get() < 0)
+            Details::FailShared("Can't create shared memory", object);
+
+        auto const length = contents.GetLength();
+        if (::ftruncate(fd.Get(), static_cast<off_t> (length)) != 0)
+            Details::FailShared("Can't size shared memory", object);
+
+        Details::SharedWritableMapping const mapping(fd.Get(), length, object);
+        auto position = static_cast<unsigned char *> (mapping.Get());
+        contents.WriteTo([&position] (void const *const bytes, std::size_t const nr_bytes) {
+            std::memcpy(position, bytes, nr_bytes);
+            position += nr_bytes;
+        });
+    }
+    catch (...) {
+        ::shm_unlink(object.c_str());
+        throw;
+    }
+
+    std::memcpy(control->magic, Details::SharedControlBlock::Magic(), sizeof control->magic);
+    control->generation.store(generation, std::memory_order_release);
+    if (previous != 0)
+        ::shm_unlink(Details::SharedGenerationName(name, previous).c_str());
+
+    return generation;
+}
+
+// Remove a published name and its current generation, if there is one.
+// Junctions already attached keep their elements, but are no longer current.
+inline void Unpublish(std::string const &name) {
+    Details::SharedDescriptor const fd(::shm_open(name.c_str(), O_RDWR, 0));
+    if (fd.Get() < 0)
+        return;
+
+    struct stat status;
+    if (::fstat(fd.Get(), &status) == 0 and
+        static_cast<std::size_t> (status.st_size) >= sizeof(Details::SharedControlBlock)) {
+        Details::SharedWritableMapping const mapping(fd.Get(), sizeof(Details::SharedControlBlock), name);
+        auto const block = static_cast<Details::SharedControlBlock *> (mapping.Get());
+        auto const generation = block->generation.exchange(Details::SharedControlBlock::Retired, std::memory_order_acq_rel);
+        if (generation != 0 and generation != Details::SharedControlBlock::Retired)
+            ::shm_unlink(Details::SharedGenerationName(name, generation).c_str());
+    }
+
+    ::shm_unlink(name.c_str());
+}
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,335 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionSnapshot_h
+#define      P6JunctionSnapshot_h
+
+// Saves the elements of a junction of numbers to a file, and loads them
+// again, so that a process can start with junctions that were built by an
+// earlier one.  The file can also be mapped straight into memory by the
+// xxx_mapped() helpers -- see JunctionMappedFileStore.h -- which then need no
+// parsing and no allocation per element.
+//
+// The file begins with a 32-byte header:
+//
+//     Offset  Size  Field
+//          0     8  Magic number: the characters "P6JUNCT" and a NUL
+//          8     4  Version: 1 or 2
+//         12     4  Width of each element, in bytes
+//         16     8  Number of elements
+//         24     4  Kind: 0 for unsigned integers, 1 for signed, 2 for floats
+//         28     4  Flags: 1 if sorted in ascending order, 2 if unique too,
+//                   and, from version 2, 4 if an index follows the elements
+//
+// Every field is little-endian, and the elements follow.  The index, if there
+// is one, holds every 256th element, starting with the first, so that a lookup
+// can search it first and then only one block of 256 elements, touching far
+// fewer pages than a binary search of the whole file.  A file without the
+// header holds nothing but elements, as in a file written by other software.
+//
+// Save() always writes sorted, unique elements, and it writes them to a
+// temporary file that it then renames, so that a process loading the file
+// never sees half of it.  On Unix-like systems, it also flushes the file to
+// the disk before renaming it, and the directory afterwards, so that once it
+// returns, the new file survives a crash or a power cut; elsewhere, it
+// promises only that readers see either the old file or the new one.
+
+#include "Junction.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined __unix__ || defined __APPLE__
+#define P6_HAVE_FSYNC
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace P6 { namespace Details {
+
+struct MappedFileHeader {
+    static std::uint32_t const CurrentVersion {2};
+    static std::size_t   const IndexStride    {256};
+
+    enum Kind: std::uint32_t {Unsigned, Signed, Float};
+
+    enum Flags: std::uint32_t {
+        Sorted   = 1,
+        Unique   = 2,
+        HasIndex = 4
+    };
+
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t width;
+    std::uint64_t count;
+    std::uint32_t kind;
+    std::uint32_t flags;
+
+    static char const *Magic() {
+        return "P6JUNCT";
+    }
+
+    template<typename T>
+    static std::uint32_t KindOf() {
+        return std::is_floating_point<T>::value? Float:
+               std::is_signed<T>::value?         Signed:
+                                                 Unsigned;
+    }
+
+    static std::size_t IndexSize(std::size_t const nr_elements) {
+        return (nr_elements + IndexStride - 1) / IndexStride;
+    }
+};
+
+static_assert(sizeof(MappedFileHeader) == 32, "MappedFileHeader must match the file format");
+
+template<typename T>
+struct CheckSnapshotElement {
+    static_assert(std::is_arithmetic<T>::value, "Only junctions of numbers can be saved, loaded or mapped");
+
+#if defined __BYTE_ORDER__
+    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Snapshots are little-endian, and so is this machine");
+#endif
+};
+
+[[noreturn]] inline void RejectSnapshot(std::string const &path, char const *const why) {
+    throw std::runtime_error(path + ": " + why);
+}
+
+// Where things are in a file, given its first bytes and its length:
+struct SnapshotLayout {
+    bool          has_header;
+    std::uint32_t flags;
+    std::size_t   nr_elements;
+    std::size_t   elements_offset;
+    std::size_t   index_offset;
+    std::size_t   index_size;
+
+    template<typename T>
+    static SnapshotLayout Find(unsigned char const *const start, std::size_t const length, std::string const &path) {
+        CheckSnapshotElement<T> {};
+        SnapshotLayout layout {false, 0, 0, 0, 0, 0};
+
+        MappedFileHeader header;
+        if (length < sizeof header or std::memcmp(start, MappedFileHeader::Magic(), sizeof header.magic) != 0) {
+            if (length % sizeof(T) != 0)
+                RejectSnapshot(path, "file size isn't a multiple of the element size");
+
+            layout.nr_elements = length / sizeof(T);
+            return layout;
+        }
+
+        std::memcpy(&header, start, sizeof header);
+        if (header.version == 0 or header.version > MappedFileHeader::CurrentVersion)
+            RejectSnapshot(path, "unsupported header version");
+        if (header.width != sizeof(T) or header.kind != MappedFileHeader::KindOf<T> ())
+            RejectSnapshot(path, "elements don't match the junction's element type");
+        if ((header.flags & MappedFileHeader::HasIndex) != 0 and header.version < 2)
+            RejectSnapshot(path, "index in a version 1 file");
+
+        layout.has_header      = true;
+        layout.flags           = header.flags;
+        layout.nr_elements     = static_cast<std::size_t> (header.count);
+        layout.elements_offset = sizeof header;
+        layout.index_offset    = layout.elements_offset + layout.nr_elements * sizeof(T);
+        if (header.flags & MappedFileHeader::HasIndex)
+            layout.index_size = MappedFileHeader::IndexSize(layout.nr_elements);
+
+        if (header.count > (length - sizeof header) / sizeof(T) or
+            length != layout.index_offset + layout.index_size * sizeof(T))
+            RejectSnapshot(path, "header's element count doesn't match the file size");
+
+        return layout;
+    }
+};
+
+// The header, elements and index that Save() writes, built from any junction
+// of numbers:
+template<typename Element>
+class SnapshotContents {
+    MappedFileHeader     header;
+    std::vector<Element> elements;
+
+public:
+    template<typename Store>
+    SnapshotContents(Junction<Store> const &junction, bool const with_index) {
+        CheckSnapshotElement<Element> {};
+        for (auto const &elem: junction.Elements())
+            elements.push_back(elem);
+
+        if (not std::is_sorted(elements.begin(), elements.end()))
+            std::sort(elements.begin(), elements.end());
+
+        elements.erase(std::unique(elements.begin(), elements.end()), elements.end());
+
+        std::memcpy(header.magic, MappedFileHeader::Magic(), sizeof header.magic);
+        header.version = MappedFileHeader::CurrentVersion;
+        header.width   = sizeof(Element);
+        header.count   = elements.size();
+        header.kind    = MappedFileHeader::KindOf<Element> ();
+        header.flags   = MappedFileHeader::Sorted | MappedFileHeader::Unique;
+        if (with_index)
+            header.flags |= MappedFileHeader::HasIndex;
+    }
+
+    std::size_t GetLength() const {
+        auto const index_size = header.flags & MappedFileHeader::HasIndex? MappedFileHeader::IndexSize(elements.size()): 0;
+        return sizeof header + (elements.size() + index_size) * sizeof(Element);
+    }
+
+    // Pass the file's contents, in order, to a function taking a pointer and
+    // a number of bytes:
+    template<typename Write>
+    void WriteTo(Write &&write) const {
+        write(&header, sizeof header);
+        write(elements.data(), elements.size() * sizeof(Element));
+        if (header.flags & MappedFileHeader::HasIndex)
+            for (std::size_t i = 0;  i < elements.size();  i += MappedFileHeader::IndexStride)
+                write(&elements[i], sizeof(Element));
+    }
+};
+
+#if defined P6_HAVE_FSYNC
+
+// Write the temporary file and flush it to the disk, so that the rename can't
+// reach the disk before the data does:
+template<typename Contents>
+void WriteSnapshotFile(std::string const &temporary, Contents const &contents) {
+    int const fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+        RejectSnapshot(temporary, "can't create the file");
+
+    bool ok = true;
+    contents.WriteTo([fd, &ok] (void const *const bytes, std::size_t const length) {
+        auto next = static_cast<char const *> (bytes);
+        auto left = length;
+        while (ok and left != 0) {
+            auto const written = ::write(fd, next, left);
+            if (written > 0) {
+                next += written;
+                left -= static_cast<std::size_t> (written);
+            }
+            else if (written == 0 or errno != EINTR) {
+                ok = false;
+            }
+        }
+    });
+
+    ok = ok and ::fsync(fd) == 0;
+    ok = ::close(fd) == 0 and ok;
+    if (not ok) {
+        std::remove(temporary.c_str());
+        RejectSnapshot(temporary, "can't write the file");
+    }
+}
+
+// Flush the directory holding a file that's just been renamed into it, so
+// that the new name survives a crash too:
+inline void SyncDirectoryOf(std::string const &path) {
+    auto const slash = path.rfind('/');
+    auto const directory = slash == std::string::npos? std::string {"."}:
+                           slash == 0?                 std::string {"/"}:
+                                                       path.substr(0, slash);
+
+    int const fd = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        RejectSnapshot(path, "can't open the directory to flush it");
+
+    bool const ok = ::fsync(fd) == 0;
+    ::close(fd);
+    if (not ok)
+        RejectSnapshot(path, "can't flush the directory");
+}
+
+#else
+
+template<typename Contents>
+void WriteSnapshotFile(std::string const &temporary, Contents const &contents) {
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    contents.WriteTo([&out] (void const *const bytes, std::size_t const length) {
+        out.write(static_cast<char const *> (bytes), static_cast<std::streamsize> (length));
+    });
+
+    out.close();
+    if (not out) {
+        std::remove(temporary.c_str());
+        RejectSnapshot(temporary, "can't write the file");
+    }
+}
+
+inline void SyncDirectoryOf(std::string const &)   { }
+
+#endif
+
+} // Out of namespace Details
+
+// Save the elements of any junction of numbers, sorted and without
+// duplicates, optionally followed by an index.  Failing to write the file, or,
+// on Unix-like systems, to flush it or its directory to the disk, throws
+// std::runtime_error.
+template<typename Store>
+void Save(Junction<Store> const &junction, std::string const &path, bool const with_index = true) {
+    Details::SnapshotContents<typename Store::Element> const contents(junction, with_index);
+
+    auto const temporary = path + ".tmp";
+    Details::WriteSnapshotFile(temporary, contents);
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        Details::RejectSnapshot(path, "can't replace the file");
+    }
+
+    Details::SyncDirectoryOf(path);
+}
+
+// Load the elements from a file into a vector, ignoring any index.  Failing to
+// read the file, or a header that doesn't match the element type, throws
+// std::runtime_error.
+template<typename Element>
+std::vector<Element> Load(std::string const &path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (not in)
+        Details::RejectSnapshot(path, "can't open the file");
+
+    auto const length = static_cast<std::size_t> (in.tellg());
+    in.seekg(0);
+
+    unsigned char start[sizeof(Details::MappedFileHeader)] {};
+    in.read(reinterpret_cast<char *> (start), std::min(length, sizeof start));
+    auto const layout = Details::SnapshotLayout::Find<Element> (start, length, path);
+
+    std::vector<Element> elements(layout.nr_elements);
+    in.seekg(static_cast<std::streamoff> (layout.elements_offset));
+    in.read(reinterpret_cast<char *> (elements.data()), elements.size() * sizeof(Element));
+    if (not in)
+        Details::RejectSnapshot(path, "can't read the file");
+
+    return elements;
+}
+
+}
+
+#endif
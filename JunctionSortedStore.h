@@ -18,21 +18,30 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 #define      P6JunctionSortedStore_h
 
 // Stores a Junction's elements in a std::set, which is guaranteed to hold them
-// in ascending order, enabling optimisations for some comparisons.
+// in ascending order, enabling optimisations for some comparisons.  The set
+// can take its memory from any standard allocator; see JunctionAllocator.h.
 
 #include <cassert>
+#include <functional>
+#include <initializer_list>
+#include <memory>
 #include <set>
+#include <utility>
 
 namespace P6 { namespace Details {
 
-template<typename T>
+template<typename T, typename Alloc = std::allocator<T>>
 class JunctionSortedStore {
 public:
     using Element             = T;
+    using Allocator           = Alloc;
     static bool const Ordered = true;
+    static bool const Indexed = true;
 
 private:
-    std::set<Element> elements;
+    using Set = std::set<Element, std::less<Element>, Allocator>;
+
+    Set  elements;
     bool moved = false;
 
 public:
@@ -43,14 +52,48 @@ public:
     JunctionSortedStore(Iterator const begin, Iterator const end)
         : elements(begin, end)   { }
 
-    JunctionSortedStore(std::set<Element> &&elements)
-        : elements(elements),
+    JunctionSortedStore(std::initializer_list<Element> const ilist, Allocator const &allocator)
+        : elements(ilist, std::less<Element> (), allocator)   { }
+
+    template<typename Iterator>
+    JunctionSortedStore(Iterator const begin, Iterator const end, Allocator const &allocator)
+        : elements(begin, end, std::less<Element> (), allocator)   { }
+
+    JunctionSortedStore(Set &&elements)
+        : elements(std::move(elements)),
           moved(true)   { }
 
-    std::set<Element> const &Elements() const {
+    Set const &Elements() const {
         return elements;
     }
 
+    Allocator GetAllocator() const {
+        return elements.get_allocator();
+    }
+
+    // Add a value in O(log N) time, and return true if it wasn't already
+    // present.  The lowest and highest elements stay at the ends of the tree,
+    // and so ordering comparisons still take constant time afterwards.
+    bool Insert(Element const &value) {
+        return elements.insert(value).second;
+    }
+
+    // Remove a value in O(log N) time, returning true if it was present:
+    bool Erase(Element const &value) {
+        return elements.erase(value) != 0;
+    }
+
+    // Replace all the elements at once:
+    void Assign(std::initializer_list<Element> const ilist) {
+        elements = ilist;
+    }
+
+    template<typename Iterator>
+    void Assign(Iterator const begin, Iterator const end) {
+        elements.clear();
+        elements.insert(begin, end);
+    }
+
     bool IsEmpty() const {
         return elements.empty();
     }
@@ -63,6 +106,10 @@ public:
         return GetSize() >= 2;
     }
 
+    bool Contains(Element const &value) const {
+        return elements.find(value) != elements.end();
+    }
+
     // For testing:
     bool CalledMoveConstructor() const {
         return moved;
@@ -0,0 +1,130 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionStoreSelection_h
+#define      P6JunctionStoreSelection_h
+
+// Decides which store a junction uses when it copies its elements, given only
+// the type of those elements.
+
+#include "JunctionAllocator.h"
+#include "JunctionBitsetStore.h"
+#include "JunctionFlatSortedStore.h"
+#include "JunctionInlineStore.h"
+
+#include <type_traits>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#define P6_HAVE_STRING_VIEW
+#endif
+
+namespace P6 { namespace Details {
+
+// Copying a C string copies only the pointer, and pointers compare by address,
+// not by content.  Where std::string_view is available, the helper functions
+// that copy elements therefore copy C strings as string_views, which point to
+// the same characters, but which compare lexicographically:
+
+template<typename Element>
+struct CopiedElementType {
+    using type = Element;
+};
+
+#if defined P6_HAVE_STRING_VIEW
+template<>
+struct CopiedElementType<char const *> {
+    using type = std::string_view;
+};
+#endif
+
+template<typename Element>
+using CopiedElement = typename CopiedElementType<Element>::type;
+
+// Containers, pairs of iterators and the results of applying a lambda are
+// copied into a bitset if every value of the element type fits in a small
+// one, and into a sorted vector otherwise:
+
+template<typename Element>
+using CopyStoreFor = typename std::conditional<
+    HasSmallDomain<Element>::value,
+    JunctionBitsetStore<Element>,
+    JunctionFlatSortedStore<Element>
+>::type;
+
+// A temporary std::vector that would otherwise be copied into a sorted vector
+// is adopted instead, keeping its buffer and its allocator, and sorted in
+// place.  Where a copy would go elsewhere, such as into a bitset, this type
+// is undefined, and the vector is copied as usual:
+
+template<typename Element, typename Alloc>
+using AdoptedVectorStore = typename std::enable_if<
+    std::is_same<CopyStoreFor<CopiedElement<Element>>, JunctionFlatSortedStore<Element>>::value,
+    JunctionFlatSortedStore<Element, Alloc>
+>::type;
+
+// Brace-lists are usually short, and so we copy them inline when we can; a
+// JunctionInlineStore can only hold trivially copyable, default-constructible
+// elements, such as numbers and string_views, and so we fall back to a sorted
+// vector for anything else, such as std::strings:
+
+template<typename Element>
+using InitializerListStore = typename std::conditional<
+    HasSmallDomain<Element>::value,
+    JunctionBitsetStore<Element>,
+    typename std::conditional<
+        std::is_trivially_copyable<Element>::value and std::is_nothrow_default_constructible<Element>::value,
+        JunctionInlineStore<Element>,
+        JunctionFlatSortedStore<Element>
+    >::type
+>::type;
+
+// Applying a lambda to a junction copies the results into the same kind of
+// store as xxx_copy() would, unless the junction's store has an allocator of
+// its own, in which case the results go into a sorted vector that uses the
+// same allocator:
+
+template<typename Store, typename ResultElement, bool = HasCustomAllocator<Store>::value>
+struct MappedStore {
+    using type = CopyStoreFor<ResultElement>;
+};
+
+template<typename Store, typename ResultElement>
+struct MappedStore<Store, ResultElement, true> {
+    using type = JunctionFlatSortedStore<ResultElement, ReboundAllocator<typename Store::Allocator, ResultElement>>;
+};
+
+// A bitset whose domain starts at zero, as an explicitly sized domain and the
+// domain of an unsigned type do, maps integers into a bitset over the same
+// domain, even if the lambda widens them, as x + 1 does to a std::uint8_t.  A
+// result outside the domain throws std::out_of_range, as it would when
+// building any other bitset.  Results that have a small domain of their own
+// get a bitset over the whole of it instead, as with xxx_copy():
+
+template<typename T, std::size_t DomainSize, typename ResultElement>
+struct MappedStore<JunctionBitsetStore<T, DomainSize>, ResultElement, false> {
+    static bool const StartsAtZero = DomainSize != SmallDomain<T>::Size or SmallDomain<T>::Lowest == 0;
+
+    using type = typename std::conditional<
+        std::is_integral<ResultElement>::value and not HasSmallDomain<ResultElement>::value and StartsAtZero,
+        JunctionBitsetStore<ResultElement, DomainSize>,
+        CopyStoreFor<ResultElement>
+    >::type;
+};
+
+} }
+
+#endif
@@ -0,0 +1,227 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#if !defined P6JunctionVersionedPiggyBackStore_h
+#define      P6JunctionVersionedPiggyBackStore_h
+
+// Stores a Junction's elements by reference to a container passed in by the
+// caller, as JunctionPiggyBackStore does, for containers that count their own
+// mutations.  The store caches a summary of the container -- its two lowest
+// and two highest elements, and the set of distinct values it holds --
+// together with the version at which it built them, and it rebuilds them only
+// if the version has changed since.  Repeated comparisons between mutations,
+// as in (any(readings) > limit) or (id == any(blocked_ids)), then take
+// constant time, or expected constant time for equality, while the junction
+// still tracks changes to the container, as a piggyback junction should.
+//
+// Duplicates count as separate elements, just as they do when any other
+// piggyback junction scans its container.  That makes no difference to any-,
+// none- and all-junctions, which look values up in the summary, but a
+// one-junction counts how many elements equal a value, and so it still scans
+// the container for == and !=.
+//
+// The distinct values go into a hash table if the element type can be
+// hashed, and into a sorted vector otherwise.
+//
+// Rebuilding the summary after a change is serialised by a mutex, so that
+// several threads can compare the same junction at once, provided that no one
+// mutates the container meanwhile.
+
+#include "JunctionExtremesStore.h"
+#include "JunctionLookup.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+namespace P6 {
+
+// Tells junctions how to read a container's version, which must change
+// whenever the container's elements do.  By default, we call a Version()
+// method; specialise ContainerVersion for containers that spell it
+// differently.
+
+template<typename Container>
+struct ContainerVersion {
+    static auto Get(Container const &container) {
+        return container.Version();
+    }
+};
+
+namespace Details {
+
+// Can std::hash hash a type?
+
+template<typename T, typename = void>
+struct IsHashable: std::false_type { };
+
+template<typename T>
+struct IsHashable<T, decltype(static_cast<void> (std::hash<T> {} (std::declval<T const &> ())))>: std::true_type { };
+
+// The distinct values in a container, for looking values up:
+
+template<typename T, bool = IsHashable<T>::value>
+class DistinctValues {
+    std::unordered_set<T> values;
+
+public:
+    template<typename Container>
+    void Find(Container const &elements) {
+        values.clear();
+        values.insert(elements.begin(), elements.end());
+    }
+
+    bool Contains(T const &value) const {
+        return values.find(value) != values.end();
+    }
+
+    std::size_t GetSize() const {
+        return values.size();
+    }
+};
+
+template<typename T>
+class DistinctValues<T, false> {
+    std::vector<T> values;
+
+public:
+    template<typename Container>
+    void Find(Container const &elements) {
+        values.assign(elements.begin(), elements.end());
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+    }
+
+    bool Contains(T const &value) const {
+        return std::binary_search(values.begin(), values.end(), value);
+    }
+
+    std::size_t GetSize() const {
+        return values.size();
+    }
+};
+
+template<typename Container>
+class JunctionVersionedPiggyBackStore {
+public:
+    using Element             = typename Container::value_type;
+    static bool const Ordered = true;
+    static bool const Indexed = true;
+
+private:
+    using Version = typename std::decay<decltype(ContainerVersion<Container>::Get(std::declval<Container const &>()))>::type;
+
+    Container const                 &container;
+    mutable std::mutex               mutex;
+    mutable bool                     cached = false;
+    mutable Version                  version {};
+    mutable Extremes<Element>        extremes;
+    mutable DistinctValues<Element>  distinct;
+
+    // Rebuild the summary if the container has changed since we last looked:
+    void Refresh() const {
+        auto const current = ContainerVersion<Container>::Get(container);
+        std::lock_guard<std::mutex> const lock(mutex);
+        if (not cached or not(version == current)) {
+            extremes.FindCountingDuplicates(container);
+            distinct.Find(container);
+            version = current;
+            cached  = true;
+        }
+    }
+
+    Extremes<Element> const &GetExtremes() const {
+        Refresh();
+        return extremes;
+    }
+
+    DistinctValues<Element> const &GetDistinct() const {
+        Refresh();
+        return distinct;
+    }
+
+protected:
+    JunctionVersionedPiggyBackStore(Container const &container)
+        : container(container)   { }
+
+    // A std::mutex can be neither copied nor moved, and so a copy starts with
+    // an empty cache:
+    JunctionVersionedPiggyBackStore(JunctionVersionedPiggyBackStore const &other)
+        : container(other.container)   { }
+
+public:
+    Container const &Elements() const {
+        return container;
+    }
+
+    bool IsEmpty() const {
+        return container.empty();
+    }
+
+    bool HasSecondElement() const {
+        return GetExtremes().has_second;
+    }
+
+    // As for every Indexed store, the size counts distinct elements:
+    std::size_t GetSize() const {
+        return GetDistinct().GetSize();
+    }
+
+    bool Contains(Element const &value) const {
+        return GetDistinct().Contains(value);
+    }
+
+protected:
+    Element const &FirstElement() const {
+        assert(not IsEmpty());
+        return GetExtremes().first;
+    }
+
+    Element const &SecondElement() const {
+        assert(HasSecondElement());
+        return GetExtremes().second;
+    }
+
+    Element const &PenultimateElement() const {
+        assert(HasSecondElement());
+        return GetExtremes().penultimate;
+    }
+
+    Element const &LastElement() const {
+        assert(not IsEmpty());
+        return GetExtremes().last;
+    }
+
+    Element const &GetAnyElement() const {
+        assert(not IsEmpty());
+        return *container.begin();
+    }
+};
+
+// Duplicates stay in the container, and so one-junctions must count them by
+// scanning:
+
+template<typename Container>
+struct StoreIsDeduplicated<JunctionVersionedPiggyBackStore<Container>>: std::false_type { };
+
+} }
+
+#endif
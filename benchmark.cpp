@@ -0,0 +1,82 @@
+/*
+Copyright (c) 2017, Mark Stephen Laker
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "JunctionAny.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+// This source file times equality lookups, as in (any(ids) == id), against
+// junctions of various sizes held in different stores: a std::set, a flat
+// sorted vector and an Eytzinger tree.  Pass the sizes on the command line,
+// or accept the defaults of a thousand, a million and a hundred million
+// elements.  A std::set of a hundred million elements needs several
+// gigabytes, and so std::set is left out above ten million elements.
+
+using namespace P6;
+
+static std::size_t const NrProbes = 10000000;
+
+template<typename Junction>
+static void time_lookups(char const *const name, Junction const &junction, std::vector<std::uint32_t> const &probes) {
+    auto const start = std::chrono::steady_clock::now();
+    std::size_t nr_found = 0;
+    for (auto const probe: probes)
+        nr_found += junction == probe;
+
+    auto const stop = std::chrono::steady_clock::now();
+    auto const ns   = std::chrono::duration<double, std::nano> (stop - start).count();
+    std::cout << "  " << name << ": " << ns / probes.size() << " ns per lookup (" << nr_found << " found)\n";
+}
+
+static void run(std::size_t const nr_elements) {
+    if (nr_elements == 0)
+        return;
+
+    std::cout << nr_elements << " elements:\n";
+
+    // Elements are random, and so about half the probes are found:
+    std::mt19937 rng(42);
+    std::vector<std::uint32_t> elements(nr_elements);
+    for (auto &elem: elements)
+        elem = static_cast<std::uint32_t> (rng());
+
+    std::vector<std::uint32_t> probes(NrProbes);
+    for (std::size_t i = 0;  i != NrProbes;  ++i)
+        probes[i] = i % 2? elements[rng() % nr_elements]: static_cast<std::uint32_t> (rng());
+
+    if (nr_elements <= 10000000)
+        time_lookups("std::set      ", any(std::set<std::uint32_t> (elements.begin(), elements.end())), probes);
+
+    time_lookups("sorted vector ", any_copy(elements), probes);
+    time_lookups("Eytzinger tree", any_eytzinger(elements), probes);
+}
+
+int main(int const argc, char **const argv) {
+    if (argc > 1)
+        for (int i = 1;  i != argc;  ++i)
+            run(std::strtoull(argv[i], nullptr, 10));
+    else
+        for (std::size_t const nr_elements: {1000ull, 1000000ull, 100000000ull})
+            run(nr_elements);
+
+    return 0;
+}
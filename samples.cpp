@@ -73,6 +73,16 @@ void check_strings() {
     auto const all_lengths = all_names([] (auto const &str) {return str.size();});
     assert(all_lengths > 2u);
     assert(not(all_lengths > 3u));
+
+#if defined P6_HAVE_STRING_VIEW
+    // With C++17, all_sv() holds std::string_views, which compare by content
+    // but don't copy the characters, and so they never touch the heap.  Copies
+    // of C strings are held as string_views automatically:
+    auto const all_views = all_sv({"Fred", "Jim", "Sheila"});
+    assert(all_views > "Catherine");
+    assert(all_views != std::string("Clarence"));
+    assert(any({"Jill", "Catherine"}) > "Dave");
+#endif
 }
 
 int main() {
@@ -18,13 +18,27 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 #include "JunctionAny.h"
 #include "JunctionOne.h"
 
+#include <array>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <map>
 #include <mutex>
 #include <set>
+#include <sstream>
+#include <string>
+#include <system_error>
 #include <thread>
 #include <vector>
 
+#if defined P6_HAVE_MMAP
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
 // To use threads with g++, add -lpthreads to the build command line:
 #define USE_THREADS 1
 
@@ -71,149 +85,199 @@ std::vector<int> const make_const_vector();     // Unimplemented
 std::set<int> make_set();                       // Unimplemented
 std::set<int> const make_const_set();           // Unimplemented
 
-static void check(bool const ok, char const *const test_name) {
+static void check(bool const ok, char const *const area, char const *const test_name) {
     if (not ok)
-        Outputter() << "Test failed: orderedness: " << test_name << '\n';
+        Outputter() << "Test failed: " << area << ": " << test_name << '\n';
 }
 
 void check_creation_types_none() {
     auto ilist {1, 2, 3};
     auto const cilist {4, 5, 6};
 
-    check(    decltype(none(     {1, 2, 3}))     ::Ordered, "none({1, 2, 3})");
-    check(not decltype(none(     ilist))         ::Ordered, "none(ilist)");
-    check(not decltype(none(     cilist))        ::Ordered, "none(cilist)");
-    check(not decltype(none_ref( {1, 2, 3}))     ::Ordered, "none_ref({1, 2, 3})");
-    check(not decltype(none_ref( ilist))         ::Ordered, "none_ref(ilist)");
-    check(not decltype(none_ref( cilist))        ::Ordered, "none_ref(cilist)");
-    check(    decltype(none_copy({1, 2, 3}))     ::Ordered, "none_copy({1, 2, 3})");
-    check(    decltype(none_copy(ilist))         ::Ordered, "none_copy(ilist)");
+    check(    decltype(none(     {1, 2, 3}))     ::Ordered, "orderedness", "none({1, 2, 3})");
+    check(not decltype(none(     ilist))         ::Ordered, "orderedness", "none(ilist)");
+    check(not decltype(none(     cilist))        ::Ordered, "orderedness", "none(cilist)");
+    check(not decltype(none_ref( {1, 2, 3}))     ::Ordered, "orderedness", "none_ref({1, 2, 3})");
+    check(not decltype(none_ref( ilist))         ::Ordered, "orderedness", "none_ref(ilist)");
+    check(not decltype(none_ref( cilist))        ::Ordered, "orderedness", "none_ref(cilist)");
+    check(    decltype(none_copy({1, 2, 3}))     ::Ordered, "orderedness", "none_copy({1, 2, 3})");
+    check(    decltype(none_copy(ilist))         ::Ordered, "orderedness", "none_copy(ilist)");
 
     std::vector<int> v {1, 2, 3};
     std::vector<int> const cv {v};
 
-    check(not decltype(none(v))                  ::Ordered, "none(v)");
-    check(not decltype(none(cv))                 ::Ordered, "none(cv)");
-    check(    decltype(none(make_vector()))      ::Ordered, "none(make_vector())");
-    check(    decltype(none(make_const_vector()))::Ordered, "none(make_const_vector())");
-    check(not decltype(none_ref(v))              ::Ordered, "none_ref(v)");
-    check(not decltype(none_ref(cv))             ::Ordered, "none_ref(cv)");
-    check(    decltype(none_copy(v))             ::Ordered, "none_copy(v)");
-    check(    decltype(none_copy(cv))            ::Ordered, "none_copy(cv)");
-
-    check(    decltype(none(v.begin(), v.end())) ::Ordered, "none(v.begin(), v.end())");
+    check(not decltype(none(v))                  ::Ordered, "orderedness", "none(v)");
+    check(not decltype(none(cv))                 ::Ordered, "orderedness", "none(cv)");
+    check(    decltype(none(make_vector()))      ::Ordered, "orderedness", "none(make_vector())");
+    check(    decltype(none(make_const_vector()))::Ordered, "orderedness", "none(make_const_vector())");
+    check(not decltype(none_ref(v))              ::Ordered, "orderedness", "none_ref(v)");
+    check(not decltype(none_ref(cv))             ::Ordered, "orderedness", "none_ref(cv)");
+    check(    decltype(none_copy(v))             ::Ordered, "orderedness", "none_copy(v)");
+    check(    decltype(none_copy(cv))            ::Ordered, "orderedness", "none_copy(cv)");
+
+    check(not decltype(none(v.begin(), v.end()))      ::Ordered, "orderedness", "none(v.begin(), v.end())");
+    check(not decltype(none_ref(v.begin(), v.end()))  ::Ordered, "orderedness", "none_ref(v.begin(), v.end())");
+    check(    decltype(none_copy(v.begin(), v.end())) ::Ordered, "orderedness", "none_copy(v.begin(), v.end())");
+    check(    decltype(none(sorted, v))               ::Ordered, "orderedness", "none(sorted, v)");
+    check(    decltype(none(sorted, cv))              ::Ordered, "orderedness", "none(sorted, cv)");
+    check(    decltype(none(sorted, v.begin(), v.end()))::Ordered, "orderedness", "none(sorted, v.begin(), v.end())");
 
     std::set<int> s {v.begin(), v.end()};
     std::set<int> const cs {s};
-    check(not decltype(none(s))                  ::Ordered, "none(s)");
-    check(not decltype(none(cs))                 ::Ordered, "none(cs)");
-    check(    decltype(none(make_set()))         ::Ordered, "none(make_set())");
-    check(    decltype(none(make_const_set()))   ::Ordered, "none(make_const_set())");
+    check(    decltype(none(s))                  ::Ordered, "orderedness", "none(s)");
+    check(    decltype(none(cs))                 ::Ordered, "orderedness", "none(cs)");
+    check(    decltype(none(make_set()))         ::Ordered, "orderedness", "none(make_set())");
+    check(    decltype(none(make_const_set()))   ::Ordered, "orderedness", "none(make_const_set())");
 }
 
 void check_creation_types_one() {
     auto ilist {1, 2, 3};
     auto const cilist {4, 5, 6};
 
-    check(    decltype(one(     {1, 2, 3}))     ::Ordered, "one({1, 2, 3})");
-    check(not decltype(one(     ilist))         ::Ordered, "one(ilist)");
-    check(not decltype(one(     cilist))        ::Ordered, "one(cilist)");
-    check(not decltype(one_ref( {1, 2, 3}))     ::Ordered, "one_ref({1, 2, 3})");
-    check(not decltype(one_ref( ilist))         ::Ordered, "one_ref(ilist)");
-    check(not decltype(one_ref( cilist))        ::Ordered, "one_ref(cilist)");
-    check(    decltype(one_copy({1, 2, 3}))     ::Ordered, "one_copy({1, 2, 3})");
-    check(    decltype(one_copy(ilist))         ::Ordered, "one_copy(ilist)");
+    check(    decltype(one(     {1, 2, 3}))     ::Ordered, "orderedness", "one({1, 2, 3})");
+    check(not decltype(one(     ilist))         ::Ordered, "orderedness", "one(ilist)");
+    check(not decltype(one(     cilist))        ::Ordered, "orderedness", "one(cilist)");
+    check(not decltype(one_ref( {1, 2, 3}))     ::Ordered, "orderedness", "one_ref({1, 2, 3})");
+    check(not decltype(one_ref( ilist))         ::Ordered, "orderedness", "one_ref(ilist)");
+    check(not decltype(one_ref( cilist))        ::Ordered, "orderedness", "one_ref(cilist)");
+    check(    decltype(one_copy({1, 2, 3}))     ::Ordered, "orderedness", "one_copy({1, 2, 3})");
+    check(    decltype(one_copy(ilist))         ::Ordered, "orderedness", "one_copy(ilist)");
 
     std::vector<int> v {1, 2, 3};
     std::vector<int> const cv {v};
 
-    check(not decltype(one(v))                  ::Ordered, "one(v)");
-    check(not decltype(one(cv))                 ::Ordered, "one(cv)");
-    check(    decltype(one(make_vector()))      ::Ordered, "one(make_vector())");
-    check(    decltype(one(make_const_vector()))::Ordered, "one(make_const_vector())");
-    check(not decltype(one_ref(v))              ::Ordered, "one_ref(v)");
-    check(not decltype(one_ref(cv))             ::Ordered, "one_ref(cv)");
-    check(    decltype(one_copy(v))             ::Ordered, "one_copy(v)");
-    check(    decltype(one_copy(cv))            ::Ordered, "one_copy(cv)");
-
-    check(    decltype(one(v.begin(), v.end())) ::Ordered, "one(v.begin(), v.end())");
+    check(not decltype(one(v))                  ::Ordered, "orderedness", "one(v)");
+    check(not decltype(one(cv))                 ::Ordered, "orderedness", "one(cv)");
+    check(    decltype(one(make_vector()))      ::Ordered, "orderedness", "one(make_vector())");
+    check(    decltype(one(make_const_vector()))::Ordered, "orderedness", "one(make_const_vector())");
+    check(not decltype(one_ref(v))              ::Ordered, "orderedness", "one_ref(v)");
+    check(not decltype(one_ref(cv))             ::Ordered, "orderedness", "one_ref(cv)");
+    check(    decltype(one_copy(v))             ::Ordered, "orderedness", "one_copy(v)");
+    check(    decltype(one_copy(cv))            ::Ordered, "orderedness", "one_copy(cv)");
+
+    check(not decltype(one(v.begin(), v.end()))       ::Ordered, "orderedness", "one(v.begin(), v.end())");
+    check(not decltype(one_ref(v.begin(), v.end()))   ::Ordered, "orderedness", "one_ref(v.begin(), v.end())");
+    check(    decltype(one_copy(v.begin(), v.end()))  ::Ordered, "orderedness", "one_copy(v.begin(), v.end())");
+    check(    decltype(one(sorted, v))                ::Ordered, "orderedness", "one(sorted, v)");
+    check(    decltype(one(sorted, cv))               ::Ordered, "orderedness", "one(sorted, cv)");
+    check(    decltype(one(sorted, v.begin(), v.end()))::Ordered, "orderedness", "one(sorted, v.begin(), v.end())");
 
     std::set<int> s {v.begin(), v.end()};
     std::set<int> const cs {s};
-    check(not decltype(one(s))                  ::Ordered, "one(s)");
-    check(not decltype(one(cs))                 ::Ordered, "one(cs)");
-    check(    decltype(one(make_set()))         ::Ordered, "one(make_set())");
-    check(    decltype(one(make_const_set()))   ::Ordered, "one(make_const_set())");
+    check(    decltype(one(s))                  ::Ordered, "orderedness", "one(s)");
+    check(    decltype(one(cs))                 ::Ordered, "orderedness", "one(cs)");
+    check(    decltype(one(make_set()))         ::Ordered, "orderedness", "one(make_set())");
+    check(    decltype(one(make_const_set()))   ::Ordered, "orderedness", "one(make_const_set())");
 }
 
 void check_creation_types_any() {
     auto ilist {1, 2, 3};
     auto const cilist {4, 5, 6};
 
-    check(    decltype(any(     {1, 2, 3}))     ::Ordered, "any({1, 2, 3})");
-    check(not decltype(any(     ilist))         ::Ordered, "any(ilist)");
-    check(not decltype(any(     cilist))        ::Ordered, "any(cilist)");
-    check(not decltype(any_ref( {1, 2, 3}))     ::Ordered, "any_ref({1, 2, 3})");
-    check(not decltype(any_ref( ilist))         ::Ordered, "any_ref(ilist)");
-    check(not decltype(any_ref( cilist))        ::Ordered, "any_ref(cilist)");
-    check(    decltype(any_copy({1, 2, 3}))     ::Ordered, "any_copy({1, 2, 3})");
-    check(    decltype(any_copy(ilist))         ::Ordered, "any_copy(ilist)");
+    check(    decltype(any(     {1, 2, 3}))     ::Ordered, "orderedness", "any({1, 2, 3})");
+    check(not decltype(any(     ilist))         ::Ordered, "orderedness", "any(ilist)");
+    check(not decltype(any(     cilist))        ::Ordered, "orderedness", "any(cilist)");
+    check(not decltype(any_ref( {1, 2, 3}))     ::Ordered, "orderedness", "any_ref({1, 2, 3})");
+    check(not decltype(any_ref( ilist))         ::Ordered, "orderedness", "any_ref(ilist)");
+    check(not decltype(any_ref( cilist))        ::Ordered, "orderedness", "any_ref(cilist)");
+    check(    decltype(any_copy({1, 2, 3}))     ::Ordered, "orderedness", "any_copy({1, 2, 3})");
+    check(    decltype(any_copy(ilist))         ::Ordered, "orderedness", "any_copy(ilist)");
 
     std::vector<int> v {1, 2, 3};
     std::vector<int> const cv {v};
 
-    check(not decltype(any(v))                  ::Ordered, "any(v)");
-    check(not decltype(any(cv))                 ::Ordered, "any(cv)");
-    check(    decltype(any(make_vector()))      ::Ordered, "any(make_vector())");
-    check(    decltype(any(make_const_vector()))::Ordered, "any(make_const_vector())");
-    check(not decltype(any_ref(v))              ::Ordered, "any_ref(v)");
-    check(not decltype(any_ref(cv))             ::Ordered, "any_ref(cv)");
-    check(    decltype(any_copy(v))             ::Ordered, "any_copy(v)");
-    check(    decltype(any_copy(cv))            ::Ordered, "any_copy(cv)");
-
-    check(    decltype(any(v.begin(), v.end())) ::Ordered, "any(v.begin(), v.end())");
+    check(not decltype(any(v))                  ::Ordered, "orderedness", "any(v)");
+    check(not decltype(any(cv))                 ::Ordered, "orderedness", "any(cv)");
+    check(    decltype(any(make_vector()))      ::Ordered, "orderedness", "any(make_vector())");
+    check(    decltype(any(make_const_vector()))::Ordered, "orderedness", "any(make_const_vector())");
+    check(not decltype(any_ref(v))              ::Ordered, "orderedness", "any_ref(v)");
+    check(not decltype(any_ref(cv))             ::Ordered, "orderedness", "any_ref(cv)");
+    check(    decltype(any_copy(v))             ::Ordered, "orderedness", "any_copy(v)");
+    check(    decltype(any_copy(cv))            ::Ordered, "orderedness", "any_copy(cv)");
+
+    check(not decltype(any(v.begin(), v.end()))       ::Ordered, "orderedness", "any(v.begin(), v.end())");
+    check(not decltype(any_ref(v.begin(), v.end()))   ::Ordered, "orderedness", "any_ref(v.begin(), v.end())");
+    check(    decltype(any_copy(v.begin(), v.end()))  ::Ordered, "orderedness", "any_copy(v.begin(), v.end())");
+    check(    decltype(any(sorted, v))                ::Ordered, "orderedness", "any(sorted, v)");
+    check(    decltype(any(sorted, cv))               ::Ordered, "orderedness", "any(sorted, cv)");
+    check(    decltype(any(sorted, v.begin(), v.end()))::Ordered, "orderedness", "any(sorted, v.begin(), v.end())");
 
     std::set<int> s {v.begin(), v.end()};
     std::set<int> const cs {s};
-    check(not decltype(any(s))                  ::Ordered, "any(s)");
-    check(not decltype(any(cs))                 ::Ordered, "any(cs)");
-    check(    decltype(any(make_set()))         ::Ordered, "any(make_set())");
-    check(    decltype(any(make_const_set()))   ::Ordered, "any(make_const_set())");
+    check(    decltype(any(s))                  ::Ordered, "orderedness", "any(s)");
+    check(    decltype(any(cs))                 ::Ordered, "orderedness", "any(cs)");
+
+    // Other containers that are known to be sorted get the same treatment,
+    // but a set sorted in descending order doesn't:
+    std::multiset<int> ms {v.begin(), v.end()};
+    std::map<int, char> m {{1, 'a'}, {2, 'b'}};
+    std::set<int, std::greater<int>> gs {v.begin(), v.end()};
+    check(    decltype(any(ms))                 ::Ordered, "orderedness", "any(ms)");
+    check(    decltype(any(m))                  ::Ordered, "orderedness", "any(m)");
+    check(not decltype(any(gs))                 ::Ordered, "orderedness", "any(gs)");
+    check(    decltype(any(make_set()))         ::Ordered, "orderedness", "any(make_set())");
+    check(    decltype(any(make_const_set()))   ::Ordered, "orderedness", "any(make_const_set())");
 }
 
 void check_creation_types_all() {
     auto ilist {1, 2, 3};
     auto const cilist {4, 5, 6};
 
-    check(    decltype(all(     {1, 2, 3}))     ::Ordered, "all({1, 2, 3})");
-    check(not decltype(all(     ilist))         ::Ordered, "all(ilist)");
-    check(not decltype(all(     cilist))        ::Ordered, "all(cilist)");
-    check(not decltype(all_ref( {1, 2, 3}))     ::Ordered, "all_ref({1, 2, 3})");
-    check(not decltype(all_ref( ilist))         ::Ordered, "all_ref(ilist)");
-    check(not decltype(all_ref( cilist))        ::Ordered, "all_ref(cilist)");
-    check(    decltype(all_copy({1, 2, 3}))     ::Ordered, "all_copy({1, 2, 3})");
-    check(    decltype(all_copy(ilist))         ::Ordered, "all_copy(ilist)");
+    check(    decltype(all(     {1, 2, 3}))     ::Ordered, "orderedness", "all({1, 2, 3})");
+    check(not decltype(all(     ilist))         ::Ordered, "orderedness", "all(ilist)");
+    check(not decltype(all(     cilist))        ::Ordered, "orderedness", "all(cilist)");
+    check(not decltype(all_ref( {1, 2, 3}))     ::Ordered, "orderedness", "all_ref({1, 2, 3})");
+    check(not decltype(all_ref( ilist))         ::Ordered, "orderedness", "all_ref(ilist)");
+    check(not decltype(all_ref( cilist))        ::Ordered, "orderedness", "all_ref(cilist)");
+    check(    decltype(all_copy({1, 2, 3}))     ::Ordered, "orderedness", "all_copy({1, 2, 3})");
+    check(    decltype(all_copy(ilist))         ::Ordered, "orderedness", "all_copy(ilist)");
 
     std::vector<int> v {1, 2, 3};
     std::vector<int> const cv {v};
 
-    check(not decltype(all(v))                  ::Ordered, "all(v)");
-    check(not decltype(all(cv))                 ::Ordered, "all(cv)");
-    check(    decltype(all(make_vector()))      ::Ordered, "all(make_vector())");
-    check(    decltype(all(make_const_vector()))::Ordered, "all(make_const_vector())");
-    check(not decltype(all_ref(v))              ::Ordered, "all_ref(v)");
-    check(not decltype(all_ref(cv))             ::Ordered, "all_ref(cv)");
-    check(    decltype(all_copy(v))             ::Ordered, "all_copy(v)");
-    check(    decltype(all_copy(cv))            ::Ordered, "all_copy(cv)");
-
-    check(    decltype(all(v.begin(), v.end())) ::Ordered, "all(v.begin(), v.end())");
+    check(not decltype(all(v))                  ::Ordered, "orderedness", "all(v)");
+    check(not decltype(all(cv))                 ::Ordered, "orderedness", "all(cv)");
+    check(    decltype(all(make_vector()))      ::Ordered, "orderedness", "all(make_vector())");
+    check(    decltype(all(make_const_vector()))::Ordered, "orderedness", "all(make_const_vector())");
+    check(not decltype(all_ref(v))              ::Ordered, "orderedness", "all_ref(v)");
+    check(not decltype(all_ref(cv))             ::Ordered, "orderedness", "all_ref(cv)");
+    check(    decltype(all_copy(v))             ::Ordered, "orderedness", "all_copy(v)");
+    check(    decltype(all_copy(cv))            ::Ordered, "orderedness", "all_copy(cv)");
+
+    check(not decltype(all(v.begin(), v.end()))       ::Ordered, "orderedness", "all(v.begin(), v.end())");
+    check(not decltype(all_ref(v.begin(), v.end()))   ::Ordered, "orderedness", "all_ref(v.begin(), v.end())");
+    check(    decltype(all_copy(v.begin(), v.end()))  ::Ordered, "orderedness", "all_copy(v.begin(), v.end())");
+    check(    decltype(all(sorted, v))                ::Ordered, "orderedness", "all(sorted, v)");
+    check(    decltype(all(sorted, cv))               ::Ordered, "orderedness", "all(sorted, cv)");
+    check(    decltype(all(sorted, v.begin(), v.end()))::Ordered, "orderedness", "all(sorted, v.begin(), v.end())");
 
     std::set<int> s {v.begin(), v.end()};
     std::set<int> const cs {s};
-    check(not decltype(all(s))                  ::Ordered, "all(s)");
-    check(not decltype(all(cs))                 ::Ordered, "all(cs)");
-    check(    decltype(all(make_set()))         ::Ordered, "all(make_set())");
-    check(    decltype(all(make_const_set()))   ::Ordered, "all(make_const_set())");
+    check(    decltype(all(s))                  ::Ordered, "orderedness", "all(s)");
+    check(    decltype(all(cs))                 ::Ordered, "orderedness", "all(cs)");
+    check(    decltype(all(make_set()))         ::Ordered, "orderedness", "all(make_set())");
+    check(    decltype(all(make_const_set()))   ::Ordered, "orderedness", "all(make_const_set())");
+}
+
+// Temporary vectors and sets are adopted, not copied: the junction keeps the
+// same buffer or the same tree nodes.
+
+void check_adopted_containers() {
+    std::vector<int> v {5, 3, 5, 1};
+    auto const buffer = v.data();
+    auto const adopted = any(std::move(v));
+    check(adopted.Elements().data() == buffer,                  "adopted containers", "any(std::move(v)) keeps the buffer");
+    check(adopted.GetSize() == 3 and adopted == 5,              "adopted containers", "any(std::move(v)) sorts and deduplicates");
+
+    std::vector<int> w {1, 2, 3};
+    auto const sorted_buffer = w.data();
+    check(all(sorted, std::move(w)).Elements().data() == sorted_buffer, "adopted containers", "all(sorted, std::move(w)) keeps the buffer");
+
+    std::set<int> s {1, 2, 3};
+    auto const node = &*s.begin();
+    auto const moved = none(std::move(s));
+    check(moved.CalledMoveConstructor(),                        "adopted containers", "none(std::move(s)) moves");
+    check(&*moved.Elements().begin() == node,                   "adopted containers", "none(std::move(s)) keeps the nodes");
 }
 
 void check_creation_types() {
@@ -221,6 +285,7 @@ void check_creation_types() {
     check_creation_types_one();
     check_creation_types_any();
     check_creation_types_all();
+    check_adopted_containers();
 }
 
 // The six arithmetic (or pseudo-arithmetic) comparisons:
@@ -355,7 +420,7 @@ static void compare_untouched_against_constant(Junction const &junction, Numbers
 
 template<typename Junction>
 static void compare_bumped_against_constant(Junction const &untouched_junction, Numbers const &nums, MatchCount match_count, char const *const test_name) {
-    auto junction = untouched_junction([] (auto n) {return n + 1; });
+    auto junction = untouched_junction([] (auto n) {return static_cast<decltype(n)> (n + 1); });
 
     for (auto comparison = Compare::First;  comparison <= Compare::Last;  ++comparison) {
 
@@ -415,6 +480,32 @@ static void compare_junction_with_constant(Lambda lambda) {
     }
 }
 
+// A container adapter that counts its own mutations, as junctions made by
+// xxx_versioned() require:
+
+template<typename T>
+class VersionedVector {
+    std::vector<T> elements;
+    unsigned       version = 0;
+
+public:
+    using value_type = T;
+
+    VersionedVector(std::initializer_list<T> const ilist): elements(ilist)   { }
+
+    template<typename Iterator>
+    void Assign(Iterator const begin, Iterator const end) {
+        elements.assign(begin, end);
+        ++version;
+    }
+
+    auto begin()   const {return elements.begin();}
+    auto end()     const {return elements.end();}
+    bool empty()   const {return elements.empty();}
+    auto size()    const {return elements.size();}
+    auto Version() const {return version;}
+};
+
 // Display a junction type:
 
 static std::ostream &operator << (std::ostream &os, JunctionType const type) {
@@ -477,6 +568,13 @@ static void compare_none_empty() {
     compare_empty(none(vec), true);
     compare_empty(none_ref(vec), true);
     compare_empty(none_copy(vec), true);
+    compare_empty(none_lazy(vec), true);
+    compare_empty(none_extremes(vec), true);
+    compare_empty(none_packed(vec), true);
+    compare_empty(none_eytzinger(vec), true);
+    compare_empty(none_roaring(vec), true);
+    compare_empty(none_bitset<4>(vec), true);
+    compare_empty(none_hash(vec), true);
     compare_empty(none(std::move(vec)), true);
 
     std::vector<unsigned> const cvec;
@@ -542,12 +640,25 @@ static void compare_none_monadic() {
     compare_none_monadic(none_ref(ilist));
     compare_none_monadic(none_copy(ilist));
 
+    // Brace-lists are copied inline if they're small enough and spill to the
+    // heap otherwise; either way, duplicates must disappear:
+    compare_none_monadic(none({1u, 1u, 1u}));
+    compare_none_monadic(none({1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u}));
+    compare_none_monadic(none<std::uint8_t> ({1u, 1u}));
+
     std::vector<unsigned> vec {1u};
     std::vector<unsigned> const cvec {vec};
     compare_none_monadic(none(vec.begin(), vec.end()));
     compare_none_monadic(none(vec));
     compare_none_monadic(none_ref(vec));
     compare_none_monadic(none_copy(vec));
+    compare_none_monadic(none_lazy(vec));
+    compare_none_monadic(none_extremes(vec));
+    compare_none_monadic(none_packed(vec));
+    compare_none_monadic(none_eytzinger(vec));
+    compare_none_monadic(none_roaring(vec));
+    compare_none_monadic(none_bitset<4>(vec));
+    compare_none_monadic(none_hash(vec));
     compare_none_monadic(none(std::move(vec)));
     compare_none_monadic(none(cvec.begin(), cvec.end()));
     compare_none_monadic(none(cvec));
@@ -579,11 +690,56 @@ static void compare_none_triadic() {
         compare_against_constant(none(std::move(ilist)), nums, MatchCount::None, "none (move init list) against constant");
 
         std::vector<unsigned> vec {nums.a, nums.b, nums.c};
+        MonotonicArena arena;
         std::vector<unsigned> const cvec {vec};
         compare_against_constant(none(vec), nums, MatchCount::None, "none (vector) against constant");
         compare_against_constant(none_copy(vec), nums, MatchCount::None, "none_copy (vector) against constant");
+        auto none_mutable_junction = none_mutable({7u});
+        none_mutable_junction.Erase(7u);
+        for (auto const n: vec)
+            none_mutable_junction.Insert(n);
+        compare_against_constant(none_mutable_junction, nums, MatchCount::None, "none_mutable (inserted) against constant");
+        none_mutable_junction.Assign({7u, 8u});
+        none_mutable_junction.Assign(vec.begin(), vec.end());
+        compare_against_constant(none_mutable_junction, nums, MatchCount::None, "none_mutable (assigned) against constant");
+        auto none_copy_junction = none_copy(std::vector<unsigned> {7u});
+        none_copy_junction.Erase(7u);
+        for (auto const n: vec)
+            none_copy_junction.Insert(n);
+        compare_against_constant(none_copy_junction, nums, MatchCount::None, "none_copy (inserted) against constant");
+        none_copy_junction.Assign({7u, 8u});
+        none_copy_junction.Assign(vec.begin(), vec.end());
+        compare_against_constant(none_copy_junction, nums, MatchCount::None, "none_copy (assigned) against constant");
+        compare_against_constant(none_lazy(vec), nums, MatchCount::None, "none_lazy (vector) against constant");
+        compare_against_constant(none_extremes(vec), nums, MatchCount::None, "none_extremes (vector) against constant");
+        compare_against_constant(none_copy(vec, arena), nums, MatchCount::None, "none_copy (vector, arena) against constant");
+        compare_against_constant(none_hash(vec, arena), nums, MatchCount::None, "none_hash (vector, arena) against constant");
+        compare_against_constant(none_roaring(vec, arena), nums, MatchCount::None, "none_roaring (vector, arena) against constant");
+        compare_against_constant(none_eytzinger(vec, arena), nums, MatchCount::None, "none_eytzinger (vector, arena) against constant");
+        compare_against_constant(none_packed(vec, arena), nums, MatchCount::None, "none_packed (vector, arena) against constant");
+        compare_against_constant(none_extremes(vec, arena), nums, MatchCount::None, "none_extremes (vector, arena) against constant");
+        compare_against_constant(none_lazy(vec, arena), nums, MatchCount::None, "none_lazy (vector, arena) against constant");
+        compare_against_constant(none_copy(vec, std::allocator<unsigned> ()), nums, MatchCount::None, "none_copy (vector, allocator) against constant");
+#if defined P6_HAVE_PMR
+        std::pmr::monotonic_buffer_resource resource;
+        compare_against_constant(none_copy(vec, &resource), nums, MatchCount::None, "none_copy (vector, memory resource) against constant");
+#endif
+        compare_against_constant(none_packed(vec), nums, MatchCount::None, "none_packed (vector) against constant");
+        compare_against_constant(none_eytzinger(vec), nums, MatchCount::None, "none_eytzinger (vector) against constant");
+        compare_against_constant(none_roaring(vec), nums, MatchCount::None, "none_roaring (vector) against constant");
+        compare_against_constant(none_bitset<8>(vec), nums, MatchCount::None, "none_bitset (vector) against constant");
+        std::vector<std::uint8_t> const bytes(vec.begin(), vec.end());
+        compare_against_constant(none_copy(bytes), nums, MatchCount::None, "none_copy (byte vector) against constant");
+        compare_against_constant(none_hash(vec), nums, MatchCount::None, "none_hash (vector) against constant");
         compare_against_constant(none_ref(vec), nums, MatchCount::None, "none_ref (vector) against constant");
+        VersionedVector<unsigned> vvec {7u, 8u};
+        auto const none_versioned_junction = none_versioned(vvec);
+        static_cast<void> (none_versioned_junction < 0u);    // Fill the cache
+        vvec.Assign(vec.begin(), vec.end());
+        compare_against_constant(none_versioned_junction, nums, MatchCount::None, "none_versioned (vector) against constant");
         compare_against_constant(none(vec.begin(), vec.end()), nums, MatchCount::None, "none (vector iterators) against constant");
+        compare_against_constant(none_ref(vec.begin(), vec.end()), nums, MatchCount::None, "none_ref (vector iterators) against constant");
+        compare_against_constant(none_copy(vec.begin(), vec.end()), nums, MatchCount::None, "none_copy (vector iterators) against constant");
         compare_against_constant(none(std::move(vec)), nums, MatchCount::None, "none (move vector) against constant");
         compare_against_constant(none(cvec), nums, MatchCount::None, "none (const vector) against constant");
         compare_against_constant(none_copy(cvec), nums, MatchCount::None, "none_copy (const vector) against constant");
@@ -601,6 +757,16 @@ static void compare_none_triadic() {
         compare_against_constant(none_copy(cset), nums, MatchCount::None, "none_copy (const set) against constant");
         compare_against_constant(none_ref(cset), nums, MatchCount::None, "none_ref (const set) against constant");
         compare_against_constant(none(cset.begin(), cset.end()), nums, MatchCount::None, "none (const set iterators) against constant");
+
+        std::map<unsigned, char> map {{nums.a, 'a'}, {nums.b, 'b'}, {nums.c, 'c'}};
+        std::multiset<unsigned> mset {nums.a, nums.b, nums.c};
+        compare_against_constant(none(map), nums, MatchCount::None, "none (map) against constant");
+        compare_against_constant(none(mset), nums, MatchCount::None, "none (multiset) against constant");
+
+        std::vector<unsigned> const svec {cset.begin(), cset.end()};
+        compare_against_constant(none(sorted, svec), nums, MatchCount::None, "none (sorted vector) against constant");
+        compare_against_constant(none(sorted, svec.begin(), svec.end()), nums, MatchCount::None, "none (sorted vector iterators) against constant");
+        compare_against_constant(none(sorted, std::vector<unsigned> {svec}), nums, MatchCount::None, "none (sorted temporary vector) against constant");
     });
 }
 
@@ -627,6 +793,11 @@ static void compare_one_empty() {
     compare_empty(one(vec), false);
     compare_empty(one_ref(vec), false);
     compare_empty(one_copy(vec), false);
+    compare_empty(one_packed(vec), false);
+    compare_empty(one_eytzinger(vec), false);
+    compare_empty(one_roaring(vec), false);
+    compare_empty(one_bitset<4>(vec), false);
+    compare_empty(one_hash(vec), false);
     compare_empty(one(std::move(vec)), false);
 
     std::vector<unsigned> const cvec;
@@ -695,12 +866,23 @@ static void compare_one_monadic() {
     compare_uninverted_junction_monadic(one_ref(ilist));
     compare_uninverted_junction_monadic(one_copy(ilist));
 
+    // Brace-lists are copied inline if they're small enough and spill to the
+    // heap otherwise; either way, duplicates must disappear:
+    compare_uninverted_junction_monadic(one({1u, 1u, 1u}));
+    compare_uninverted_junction_monadic(one({1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u}));
+    compare_uninverted_junction_monadic(one<std::uint8_t> ({1u, 1u}));
+
     std::vector<unsigned> vec {1u};
     std::vector<unsigned> const cvec {vec};
     compare_uninverted_junction_monadic(one(vec.begin(), vec.end()));
     compare_uninverted_junction_monadic(one(vec));
     compare_uninverted_junction_monadic(one_ref(vec));
     compare_uninverted_junction_monadic(one_copy(vec));
+    compare_uninverted_junction_monadic(one_packed(vec));
+    compare_uninverted_junction_monadic(one_eytzinger(vec));
+    compare_uninverted_junction_monadic(one_roaring(vec));
+    compare_uninverted_junction_monadic(one_bitset<4>(vec));
+    compare_uninverted_junction_monadic(one_hash(vec));
     compare_uninverted_junction_monadic(one(std::move(vec)));
     compare_uninverted_junction_monadic(one(cvec.begin(), cvec.end()));
     compare_uninverted_junction_monadic(one(cvec));
@@ -732,11 +914,52 @@ static void compare_one_triadic() {
         compare_against_constant(one(std::move(ilist)), nums, MatchCount::One, "one (move init list) against constant");
 
         std::vector<unsigned> vec {nums.a, nums.b, nums.c};
+        MonotonicArena arena;
         std::vector<unsigned> const cvec {vec};
         compare_against_constant(one(vec), nums, MatchCount::One, "one (vector) against constant");
         compare_against_constant(one_copy(vec), nums, MatchCount::One, "one_copy (vector) against constant");
+        auto one_mutable_junction = one_mutable({7u});
+        one_mutable_junction.Erase(7u);
+        for (auto const n: vec)
+            one_mutable_junction.Insert(n);
+        compare_against_constant(one_mutable_junction, nums, MatchCount::One, "one_mutable (inserted) against constant");
+        one_mutable_junction.Assign({7u, 8u});
+        one_mutable_junction.Assign(vec.begin(), vec.end());
+        compare_against_constant(one_mutable_junction, nums, MatchCount::One, "one_mutable (assigned) against constant");
+        auto one_copy_junction = one_copy(std::vector<unsigned> {7u});
+        one_copy_junction.Erase(7u);
+        for (auto const n: vec)
+            one_copy_junction.Insert(n);
+        compare_against_constant(one_copy_junction, nums, MatchCount::One, "one_copy (inserted) against constant");
+        one_copy_junction.Assign({7u, 8u});
+        one_copy_junction.Assign(vec.begin(), vec.end());
+        compare_against_constant(one_copy_junction, nums, MatchCount::One, "one_copy (assigned) against constant");
+        compare_against_constant(one_copy(vec, arena), nums, MatchCount::One, "one_copy (vector, arena) against constant");
+        compare_against_constant(one_hash(vec, arena), nums, MatchCount::One, "one_hash (vector, arena) against constant");
+        compare_against_constant(one_roaring(vec, arena), nums, MatchCount::One, "one_roaring (vector, arena) against constant");
+        compare_against_constant(one_eytzinger(vec, arena), nums, MatchCount::One, "one_eytzinger (vector, arena) against constant");
+        compare_against_constant(one_packed(vec, arena), nums, MatchCount::One, "one_packed (vector, arena) against constant");
+        compare_against_constant(one_copy(vec, std::allocator<unsigned> ()), nums, MatchCount::One, "one_copy (vector, allocator) against constant");
+#if defined P6_HAVE_PMR
+        std::pmr::monotonic_buffer_resource resource;
+        compare_against_constant(one_copy(vec, &resource), nums, MatchCount::One, "one_copy (vector, memory resource) against constant");
+#endif
+        compare_against_constant(one_packed(vec), nums, MatchCount::One, "one_packed (vector) against constant");
+        compare_against_constant(one_eytzinger(vec), nums, MatchCount::One, "one_eytzinger (vector) against constant");
+        compare_against_constant(one_roaring(vec), nums, MatchCount::One, "one_roaring (vector) against constant");
+        compare_against_constant(one_bitset<8>(vec), nums, MatchCount::One, "one_bitset (vector) against constant");
+        std::vector<std::uint8_t> const bytes(vec.begin(), vec.end());
+        compare_against_constant(one_copy(bytes), nums, MatchCount::One, "one_copy (byte vector) against constant");
+        compare_against_constant(one_hash(vec), nums, MatchCount::One, "one_hash (vector) against constant");
         compare_against_constant(one_ref(vec), nums, MatchCount::One, "one_ref (vector) against constant");
+        VersionedVector<unsigned> vvec {7u, 8u};
+        auto const one_versioned_junction = one_versioned(vvec);
+        static_cast<void> (one_versioned_junction < 0u);    // Fill the cache
+        vvec.Assign(vec.begin(), vec.end());
+        compare_against_constant(one_versioned_junction, nums, MatchCount::One, "one_versioned (vector) against constant");
         compare_against_constant(one(vec.begin(), vec.end()), nums, MatchCount::One, "one (vector iterators) against constant");
+        compare_against_constant(one_ref(vec.begin(), vec.end()), nums, MatchCount::One, "one_ref (vector iterators) against constant");
+        compare_against_constant(one_copy(vec.begin(), vec.end()), nums, MatchCount::One, "one_copy (vector iterators) against constant");
         compare_against_constant(one(std::move(vec)), nums, MatchCount::One, "one (move vector) against constant");
         compare_against_constant(one(cvec), nums, MatchCount::One, "one (const vector) against constant");
         compare_against_constant(one_copy(cvec), nums, MatchCount::One, "one_copy (const vector) against constant");
@@ -754,6 +977,16 @@ static void compare_one_triadic() {
         compare_against_constant(one_copy(cset), nums, MatchCount::One, "one_copy (const set) against constant");
         compare_against_constant(one_ref(cset), nums, MatchCount::One, "one_ref (const set) against constant");
         compare_against_constant(one(cset.begin(), cset.end()), nums, MatchCount::One, "one (const set iterators) against constant");
+
+        std::map<unsigned, char> map {{nums.a, 'a'}, {nums.b, 'b'}, {nums.c, 'c'}};
+        std::multiset<unsigned> mset {nums.a, nums.b, nums.c};
+        compare_against_constant(one(map), nums, MatchCount::One, "one (map) against constant");
+        compare_against_constant(one(mset), nums, MatchCount::One, "one (multiset) against constant");
+
+        std::vector<unsigned> const svec {cset.begin(), cset.end()};
+        compare_against_constant(one(sorted, svec), nums, MatchCount::One, "one (sorted vector) against constant");
+        compare_against_constant(one(sorted, svec.begin(), svec.end()), nums, MatchCount::One, "one (sorted vector iterators) against constant");
+        compare_against_constant(one(sorted, std::vector<unsigned> {svec}), nums, MatchCount::One, "one (sorted temporary vector) against constant");
     });
 }
 
@@ -780,6 +1013,13 @@ static void compare_any_empty() {
     compare_empty(any(vec), false);
     compare_empty(any_ref(vec), false);
     compare_empty(any_copy(vec), false);
+    compare_empty(any_lazy(vec), false);
+    compare_empty(any_extremes(vec), false);
+    compare_empty(any_packed(vec), false);
+    compare_empty(any_eytzinger(vec), false);
+    compare_empty(any_roaring(vec), false);
+    compare_empty(any_bitset<4>(vec), false);
+    compare_empty(any_hash(vec), false);
     compare_empty(any(std::move(vec)), false);
 
     std::vector<unsigned> const cvec;
@@ -811,12 +1051,25 @@ static void compare_any_monadic() {
     compare_uninverted_junction_monadic(any_ref(ilist));
     compare_uninverted_junction_monadic(any_copy(ilist));
 
+    // Brace-lists are copied inline if they're small enough and spill to the
+    // heap otherwise; either way, duplicates must disappear:
+    compare_uninverted_junction_monadic(any({1u, 1u, 1u}));
+    compare_uninverted_junction_monadic(any({1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u}));
+    compare_uninverted_junction_monadic(any<std::uint8_t> ({1u, 1u}));
+
     std::vector<unsigned> vec {1u};
     std::vector<unsigned> const cvec {vec};
     compare_uninverted_junction_monadic(any(vec.begin(), vec.end()));
     compare_uninverted_junction_monadic(any(vec));
     compare_uninverted_junction_monadic(any_ref(vec));
     compare_uninverted_junction_monadic(any_copy(vec));
+    compare_uninverted_junction_monadic(any_lazy(vec));
+    compare_uninverted_junction_monadic(any_extremes(vec));
+    compare_uninverted_junction_monadic(any_packed(vec));
+    compare_uninverted_junction_monadic(any_eytzinger(vec));
+    compare_uninverted_junction_monadic(any_roaring(vec));
+    compare_uninverted_junction_monadic(any_bitset<4>(vec));
+    compare_uninverted_junction_monadic(any_hash(vec));
     compare_uninverted_junction_monadic(any(std::move(vec)));
     compare_uninverted_junction_monadic(any(cvec.begin(), cvec.end()));
     compare_uninverted_junction_monadic(any(cvec));
@@ -848,11 +1101,56 @@ static void compare_any_triadic() {
         compare_against_constant(any(std::move(ilist)), nums, MatchCount::Any, "any (move init list) against constant");
 
         std::vector<unsigned> vec {nums.a, nums.b, nums.c};
+        MonotonicArena arena;
         std::vector<unsigned> const cvec {vec};
         compare_against_constant(any(vec), nums, MatchCount::Any, "any (vector) against constant");
         compare_against_constant(any_copy(vec), nums, MatchCount::Any, "any_copy (vector) against constant");
+        auto any_mutable_junction = any_mutable({7u});
+        any_mutable_junction.Erase(7u);
+        for (auto const n: vec)
+            any_mutable_junction.Insert(n);
+        compare_against_constant(any_mutable_junction, nums, MatchCount::Any, "any_mutable (inserted) against constant");
+        any_mutable_junction.Assign({7u, 8u});
+        any_mutable_junction.Assign(vec.begin(), vec.end());
+        compare_against_constant(any_mutable_junction, nums, MatchCount::Any, "any_mutable (assigned) against constant");
+        auto any_copy_junction = any_copy(std::vector<unsigned> {7u});
+        any_copy_junction.Erase(7u);
+        for (auto const n: vec)
+            any_copy_junction.Insert(n);
+        compare_against_constant(any_copy_junction, nums, MatchCount::Any, "any_copy (inserted) against constant");
+        any_copy_junction.Assign({7u, 8u});
+        any_copy_junction.Assign(vec.begin(), vec.end());
+        compare_against_constant(any_copy_junction, nums, MatchCount::Any, "any_copy (assigned) against constant");
+        compare_against_constant(any_lazy(vec), nums, MatchCount::Any, "any_lazy (vector) against constant");
+        compare_against_constant(any_extremes(vec), nums, MatchCount::Any, "any_extremes (vector) against constant");
+        compare_against_constant(any_copy(vec, arena), nums, MatchCount::Any, "any_copy (vector, arena) against constant");
+        compare_against_constant(any_hash(vec, arena), nums, MatchCount::Any, "any_hash (vector, arena) against constant");
+        compare_against_constant(any_roaring(vec, arena), nums, MatchCount::Any, "any_roaring (vector, arena) against constant");
+        compare_against_constant(any_eytzinger(vec, arena), nums, MatchCount::Any, "any_eytzinger (vector, arena) against constant");
+        compare_against_constant(any_packed(vec, arena), nums, MatchCount::Any, "any_packed (vector, arena) against constant");
+        compare_against_constant(any_extremes(vec, arena), nums, MatchCount::Any, "any_extremes (vector, arena) against constant");
+        compare_against_constant(any_lazy(vec, arena), nums, MatchCount::Any, "any_lazy (vector, arena) against constant");
+        compare_against_constant(any_copy(vec, std::allocator<unsigned> ()), nums, MatchCount::Any, "any_copy (vector, allocator) against constant");
+#if defined P6_HAVE_PMR
+        std::pmr::monotonic_buffer_resource resource;
+        compare_against_constant(any_copy(vec, &resource), nums, MatchCount::Any, "any_copy (vector, memory resource) against constant");
+#endif
+        compare_against_constant(any_packed(vec), nums, MatchCount::Any, "any_packed (vector) against constant");
+        compare_against_constant(any_eytzinger(vec), nums, MatchCount::Any, "any_eytzinger (vector) against constant");
+        compare_against_constant(any_roaring(vec), nums, MatchCount::Any, "any_roaring (vector) against constant");
+        compare_against_constant(any_bitset<8>(vec), nums, MatchCount::Any, "any_bitset (vector) against constant");
+        std::vector<std::uint8_t> const bytes(vec.begin(), vec.end());
+        compare_against_constant(any_copy(bytes), nums, MatchCount::Any, "any_copy (byte vector) against constant");
+        compare_against_constant(any_hash(vec), nums, MatchCount::Any, "any_hash (vector) against constant");
         compare_against_constant(any_ref(vec), nums, MatchCount::Any, "any_ref (vector) against constant");
+        VersionedVector<unsigned> vvec {7u, 8u};
+        auto const any_versioned_junction = any_versioned(vvec);
+        static_cast<void> (any_versioned_junction < 0u);    // Fill the cache
+        vvec.Assign(vec.begin(), vec.end());
+        compare_against_constant(any_versioned_junction, nums, MatchCount::Any, "any_versioned (vector) against constant");
         compare_against_constant(any(vec.begin(), vec.end()), nums, MatchCount::Any, "any (vector iterators) against constant");
+        compare_against_constant(any_ref(vec.begin(), vec.end()), nums, MatchCount::Any, "any_ref (vector iterators) against constant");
+        compare_against_constant(any_copy(vec.begin(), vec.end()), nums, MatchCount::Any, "any_copy (vector iterators) against constant");
         compare_against_constant(any(std::move(vec)), nums, MatchCount::Any, "any (move vector) against constant");
         compare_against_constant(any(cvec), nums, MatchCount::Any, "any (const vector) against constant");
         compare_against_constant(any_copy(cvec), nums, MatchCount::Any, "any_copy (const vector) against constant");
@@ -870,6 +1168,16 @@ static void compare_any_triadic() {
         compare_against_constant(any_copy(cset), nums, MatchCount::Any, "any_copy (const set) against constant");
         compare_against_constant(any_ref(cset), nums, MatchCount::Any, "any_ref (const set) against constant");
         compare_against_constant(any(cset.begin(), cset.end()), nums, MatchCount::Any, "any (const set iterators) against constant");
+
+        std::map<unsigned, char> map {{nums.a, 'a'}, {nums.b, 'b'}, {nums.c, 'c'}};
+        std::multiset<unsigned> mset {nums.a, nums.b, nums.c};
+        compare_against_constant(any(map), nums, MatchCount::Any, "any (map) against constant");
+        compare_against_constant(any(mset), nums, MatchCount::Any, "any (multiset) against constant");
+
+        std::vector<unsigned> const svec {cset.begin(), cset.end()};
+        compare_against_constant(any(sorted, svec), nums, MatchCount::Any, "any (sorted vector) against constant");
+        compare_against_constant(any(sorted, svec.begin(), svec.end()), nums, MatchCount::Any, "any (sorted vector iterators) against constant");
+        compare_against_constant(any(sorted, std::vector<unsigned> {svec}), nums, MatchCount::Any, "any (sorted temporary vector) against constant");
     });
 }
 
@@ -896,6 +1204,13 @@ static void compare_all_empty() {
     compare_empty(all(vec), true);
     compare_empty(all_ref(vec), true);
     compare_empty(all_copy(vec), true);
+    compare_empty(all_lazy(vec), true);
+    compare_empty(all_extremes(vec), true);
+    compare_empty(all_packed(vec), true);
+    compare_empty(all_eytzinger(vec), true);
+    compare_empty(all_roaring(vec), true);
+    compare_empty(all_bitset<4>(vec), true);
+    compare_empty(all_hash(vec), true);
     compare_empty(all(std::move(vec)), true);
 
     std::vector<unsigned> const cvec;
@@ -927,12 +1242,25 @@ static void compare_all_monadic() {
     compare_uninverted_junction_monadic(all_ref(ilist));
     compare_uninverted_junction_monadic(all_copy(ilist));
 
+    // Brace-lists are copied inline if they're small enough and spill to the
+    // heap otherwise; either way, duplicates must disappear:
+    compare_uninverted_junction_monadic(all({1u, 1u, 1u}));
+    compare_uninverted_junction_monadic(all({1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 1u}));
+    compare_uninverted_junction_monadic(all<std::uint8_t> ({1u, 1u}));
+
     std::vector<unsigned> vec {1u};
     std::vector<unsigned> const cvec {vec};
     compare_uninverted_junction_monadic(all(vec.begin(), vec.end()));
     compare_uninverted_junction_monadic(all(vec));
     compare_uninverted_junction_monadic(all_ref(vec));
     compare_uninverted_junction_monadic(all_copy(vec));
+    compare_uninverted_junction_monadic(all_lazy(vec));
+    compare_uninverted_junction_monadic(all_extremes(vec));
+    compare_uninverted_junction_monadic(all_packed(vec));
+    compare_uninverted_junction_monadic(all_eytzinger(vec));
+    compare_uninverted_junction_monadic(all_roaring(vec));
+    compare_uninverted_junction_monadic(all_bitset<4>(vec));
+    compare_uninverted_junction_monadic(all_hash(vec));
     compare_uninverted_junction_monadic(all(std::move(vec)));
     compare_uninverted_junction_monadic(all(cvec.begin(), cvec.end()));
     compare_uninverted_junction_monadic(all(cvec));
@@ -964,11 +1292,56 @@ static void compare_all_triadic() {
         compare_against_constant(all(std::move(ilist)), nums, MatchCount::All, "all (move init list) against constant");
 
         std::vector<unsigned> vec {nums.a, nums.b, nums.c};
+        MonotonicArena arena;
         std::vector<unsigned> const cvec {vec};
         compare_against_constant(all(vec), nums, MatchCount::All, "all (vector) against constant");
         compare_against_constant(all_copy(vec), nums, MatchCount::All, "all_copy (vector) against constant");
+        auto all_mutable_junction = all_mutable({7u});
+        all_mutable_junction.Erase(7u);
+        for (auto const n: vec)
+            all_mutable_junction.Insert(n);
+        compare_against_constant(all_mutable_junction, nums, MatchCount::All, "all_mutable (inserted) against constant");
+        all_mutable_junction.Assign({7u, 8u});
+        all_mutable_junction.Assign(vec.begin(), vec.end());
+        compare_against_constant(all_mutable_junction, nums, MatchCount::All, "all_mutable (assigned) against constant");
+        auto all_copy_junction = all_copy(std::vector<unsigned> {7u});
+        all_copy_junction.Erase(7u);
+        for (auto const n: vec)
+            all_copy_junction.Insert(n);
+        compare_against_constant(all_copy_junction, nums, MatchCount::All, "all_copy (inserted) against constant");
+        all_copy_junction.Assign({7u, 8u});
+        all_copy_junction.Assign(vec.begin(), vec.end());
+        compare_against_constant(all_copy_junction, nums, MatchCount::All, "all_copy (assigned) against constant");
+        compare_against_constant(all_lazy(vec), nums, MatchCount::All, "all_lazy (vector) against constant");
+        compare_against_constant(all_extremes(vec), nums, MatchCount::All, "all_extremes (vector) against constant");
+        compare_against_constant(all_copy(vec, arena), nums, MatchCount::All, "all_copy (vector, arena) against constant");
+        compare_against_constant(all_hash(vec, arena), nums, MatchCount::All, "all_hash (vector, arena) against constant");
+        compare_against_constant(all_roaring(vec, arena), nums, MatchCount::All, "all_roaring (vector, arena) against constant");
+        compare_against_constant(all_eytzinger(vec, arena), nums, MatchCount::All, "all_eytzinger (vector, arena) against constant");
+        compare_against_constant(all_packed(vec, arena), nums, MatchCount::All, "all_packed (vector, arena) against constant");
+        compare_against_constant(all_extremes(vec, arena), nums, MatchCount::All, "all_extremes (vector, arena) against constant");
+        compare_against_constant(all_lazy(vec, arena), nums, MatchCount::All, "all_lazy (vector, arena) against constant");
+        compare_against_constant(all_copy(vec, std::allocator<unsigned> ()), nums, MatchCount::All, "all_copy (vector, allocator) against constant");
+#if defined P6_HAVE_PMR
+        std::pmr::monotonic_buffer_resource resource;
+        compare_against_constant(all_copy(vec, &resource), nums, MatchCount::All, "all_copy (vector, memory resource) against constant");
+#endif
+        compare_against_constant(all_packed(vec), nums, MatchCount::All, "all_packed (vector) against constant");
+        compare_against_constant(all_eytzinger(vec), nums, MatchCount::All, "all_eytzinger (vector) against constant");
+        compare_against_constant(all_roaring(vec), nums, MatchCount::All, "all_roaring (vector) against constant");
+        compare_against_constant(all_bitset<8>(vec), nums, MatchCount::All, "all_bitset (vector) against constant");
+        std::vector<std::uint8_t> const bytes(vec.begin(), vec.end());
+        compare_against_constant(all_copy(bytes), nums, MatchCount::All, "all_copy (byte vector) against constant");
+        compare_against_constant(all_hash(vec), nums, MatchCount::All, "all_hash (vector) against constant");
         compare_against_constant(all_ref(vec), nums, MatchCount::All, "all_ref (vector) against constant");
+        VersionedVector<unsigned> vvec {7u, 8u};
+        auto const all_versioned_junction = all_versioned(vvec);
+        static_cast<void> (all_versioned_junction < 0u);    // Fill the cache
+        vvec.Assign(vec.begin(), vec.end());
+        compare_against_constant(all_versioned_junction, nums, MatchCount::All, "all_versioned (vector) against constant");
         compare_against_constant(all(vec.begin(), vec.end()), nums, MatchCount::All, "all (vector iterators) against constant");
+        compare_against_constant(all_ref(vec.begin(), vec.end()), nums, MatchCount::All, "all_ref (vector iterators) against constant");
+        compare_against_constant(all_copy(vec.begin(), vec.end()), nums, MatchCount::All, "all_copy (vector iterators) against constant");
         compare_against_constant(all(std::move(vec)), nums, MatchCount::All, "all (move vector) against constant");
         compare_against_constant(all(cvec), nums, MatchCount::All, "all (const vector) against constant");
         compare_against_constant(all_copy(cvec), nums, MatchCount::All, "all_copy (const vector) against constant");
@@ -986,6 +1359,16 @@ static void compare_all_triadic() {
         compare_against_constant(all_copy(cset), nums, MatchCount::All, "all_copy (const set) against constant");
         compare_against_constant(all_ref(cset), nums, MatchCount::All, "all_ref (const set) against constant");
         compare_against_constant(all(cset.begin(), cset.end()), nums, MatchCount::All, "all (const set iterators) against constant");
+
+        std::map<unsigned, char> map {{nums.a, 'a'}, {nums.b, 'b'}, {nums.c, 'c'}};
+        std::multiset<unsigned> mset {nums.a, nums.b, nums.c};
+        compare_against_constant(all(map), nums, MatchCount::All, "all (map) against constant");
+        compare_against_constant(all(mset), nums, MatchCount::All, "all (multiset) against constant");
+
+        std::vector<unsigned> const svec {cset.begin(), cset.end()};
+        compare_against_constant(all(sorted, svec), nums, MatchCount::All, "all (sorted vector) against constant");
+        compare_against_constant(all(sorted, svec.begin(), svec.end()), nums, MatchCount::All, "all (sorted vector iterators) against constant");
+        compare_against_constant(all(sorted, std::vector<unsigned> {svec}), nums, MatchCount::All, "all (sorted temporary vector) against constant");
     });
 }
 
@@ -1145,13 +1528,34 @@ static void check_none_to_every_junction_type() {
         check_none_to_everything(none_ref({nums.a, nums.b, nums.c}), nums);
 
         std::vector<unsigned> vec {nums.a, nums.b, nums.c};
+        MonotonicArena arena;
         check_none_to_everything(none(vec.begin(), vec.end()), nums);
+        check_none_to_everything(none_copy(vec.begin(), vec.end()), nums);
         check_none_to_everything(none_copy(vec), nums);
+        check_none_to_everything(none_lazy(vec), nums);
+        check_none_to_everything(none_extremes(vec), nums);
+        check_none_to_everything(none_copy(vec, arena), nums);
+        check_none_to_everything(none_hash(vec, arena), nums);
+        check_none_to_everything(none_roaring(vec, arena), nums);
+        check_none_to_everything(none_eytzinger(vec, arena), nums);
+        check_none_to_everything(none_packed(vec, arena), nums);
+        check_none_to_everything(none_extremes(vec, arena), nums);
+        check_none_to_everything(none_lazy(vec, arena), nums);
+        check_none_to_everything(none_copy(vec, std::allocator<unsigned> ()), nums);
+        check_none_to_everything(none_packed(vec), nums);
+        check_none_to_everything(none_eytzinger(vec), nums);
+        check_none_to_everything(none_roaring(vec), nums);
+        check_none_to_everything(none_bitset<4>(vec), nums);
+        check_none_to_everything(none_hash(vec), nums);
         check_none_to_everything(none_ref(vec), nums);
 
         std::set<unsigned> set {nums.a, nums.b, nums.c};
         check_none_to_everything(none_copy(set), nums);
         check_none_to_everything(none_ref(set), nums);
+
+        std::vector<unsigned> const svec {set.begin(), set.end()};
+        check_none_to_everything(none(sorted, svec), nums);
+        check_none_to_everything(none(sorted, svec.begin(), svec.end()), nums);
     }
 }
 
@@ -1252,13 +1656,30 @@ static void check_one_to_every_junction_type() {
         check_one_to_everything(one_ref({nums.a, nums.b, nums.c}), nums);
 
         std::vector<unsigned> vec {nums.a, nums.b, nums.c};
+        MonotonicArena arena;
         check_one_to_everything(one(vec.begin(), vec.end()), nums);
+        check_one_to_everything(one_copy(vec.begin(), vec.end()), nums);
         check_one_to_everything(one_copy(vec), nums);
+        check_one_to_everything(one_copy(vec, arena), nums);
+        check_one_to_everything(one_hash(vec, arena), nums);
+        check_one_to_everything(one_roaring(vec, arena), nums);
+        check_one_to_everything(one_eytzinger(vec, arena), nums);
+        check_one_to_everything(one_packed(vec, arena), nums);
+        check_one_to_everything(one_copy(vec, std::allocator<unsigned> ()), nums);
+        check_one_to_everything(one_packed(vec), nums);
+        check_one_to_everything(one_eytzinger(vec), nums);
+        check_one_to_everything(one_roaring(vec), nums);
+        check_one_to_everything(one_bitset<4>(vec), nums);
+        check_one_to_everything(one_hash(vec), nums);
         check_one_to_everything(one_ref(vec), nums);
 
         std::set<unsigned> set {nums.a, nums.b, nums.c};
         check_one_to_everything(one_copy(set), nums);
         check_one_to_everything(one_ref(set), nums);
+
+        std::vector<unsigned> const svec {set.begin(), set.end()};
+        check_one_to_everything(one(sorted, svec), nums);
+        check_one_to_everything(one(sorted, svec.begin(), svec.end()), nums);
     }
 }
 
@@ -1352,13 +1773,34 @@ static void check_any_to_every_junction_type() {
         check_any_to_everything(any_ref({nums.a, nums.b, nums.c}), nums);
 
         std::vector<unsigned> vec {nums.a, nums.b, nums.c};
+        MonotonicArena arena;
         check_any_to_everything(any(vec.begin(), vec.end()), nums);
+        check_any_to_everything(any_copy(vec.begin(), vec.end()), nums);
         check_any_to_everything(any_copy(vec), nums);
+        check_any_to_everything(any_lazy(vec), nums);
+        check_any_to_everything(any_extremes(vec), nums);
+        check_any_to_everything(any_copy(vec, arena), nums);
+        check_any_to_everything(any_hash(vec, arena), nums);
+        check_any_to_everything(any_roaring(vec, arena), nums);
+        check_any_to_everything(any_eytzinger(vec, arena), nums);
+        check_any_to_everything(any_packed(vec, arena), nums);
+        check_any_to_everything(any_extremes(vec, arena), nums);
+        check_any_to_everything(any_lazy(vec, arena), nums);
+        check_any_to_everything(any_copy(vec, std::allocator<unsigned> ()), nums);
+        check_any_to_everything(any_packed(vec), nums);
+        check_any_to_everything(any_eytzinger(vec), nums);
+        check_any_to_everything(any_roaring(vec), nums);
+        check_any_to_everything(any_bitset<4>(vec), nums);
+        check_any_to_everything(any_hash(vec), nums);
         check_any_to_everything(any_ref(vec), nums);
 
         std::set<unsigned> set {nums.a, nums.b, nums.c};
         check_any_to_everything(any_copy(set), nums);
         check_any_to_everything(any_ref(set), nums);
+
+        std::vector<unsigned> const svec {set.begin(), set.end()};
+        check_any_to_everything(any(sorted, svec), nums);
+        check_any_to_everything(any(sorted, svec.begin(), svec.end()), nums);
     }
 }
 
@@ -1452,13 +1894,34 @@ static void check_all_to_every_junction_type() {
         check_all_to_everything(all_ref({nums.a, nums.b, nums.c}), nums);
 
         std::vector<unsigned> vec {nums.a, nums.b, nums.c};
+        MonotonicArena arena;
         check_all_to_everything(all(vec.begin(), vec.end()), nums);
+        check_all_to_everything(all_copy(vec.begin(), vec.end()), nums);
         check_all_to_everything(all_copy(vec), nums);
+        check_all_to_everything(all_lazy(vec), nums);
+        check_all_to_everything(all_extremes(vec), nums);
+        check_all_to_everything(all_copy(vec, arena), nums);
+        check_all_to_everything(all_hash(vec, arena), nums);
+        check_all_to_everything(all_roaring(vec, arena), nums);
+        check_all_to_everything(all_eytzinger(vec, arena), nums);
+        check_all_to_everything(all_packed(vec, arena), nums);
+        check_all_to_everything(all_extremes(vec, arena), nums);
+        check_all_to_everything(all_lazy(vec, arena), nums);
+        check_all_to_everything(all_copy(vec, std::allocator<unsigned> ()), nums);
+        check_all_to_everything(all_packed(vec), nums);
+        check_all_to_everything(all_eytzinger(vec), nums);
+        check_all_to_everything(all_roaring(vec), nums);
+        check_all_to_everything(all_bitset<4>(vec), nums);
+        check_all_to_everything(all_hash(vec), nums);
         check_all_to_everything(all_ref(vec), nums);
 
         std::set<unsigned> set {nums.a, nums.b, nums.c};
         check_all_to_everything(all_copy(set), nums);
         check_all_to_everything(all_ref(set), nums);
+
+        std::vector<unsigned> const svec {set.begin(), set.end()};
+        check_all_to_everything(all(sorted, svec), nums);
+        check_all_to_everything(all(sorted, svec.begin(), svec.end()), nums);
     }
 }
 
@@ -1485,12 +1948,576 @@ static void compare_junctions_with_junctions() {
 
 #endif
 
+// String views compare by content, whatever kind of string they're compared
+// with, and so do copies of C strings:
+
+#if defined P6_HAVE_STRING_VIEW
+
+static void check_string_views() {
+    std::string const jim {"Jim"};
+    char const jill[] {"Jill"};
+
+    auto const names = all_sv({"Fred", "Jim", "Sheila"});
+    check(names >  "Catherine",                     "string views", "all > C string");
+    check(not(names > std::string {"Jim"}),         "string views", "all > std::string");
+    check(names != std::string_view {"Clarence"},   "string views", "all != string_view");
+    check("Clarence" < names,                       "string views", "C string < all");
+
+    check(any_sv({"Fred", "Jim"}) == jim,           "string views", "any == std::string");
+    check(none_sv({"Fred", "Jim"}) == jill,         "string views", "none == char array");
+    check(one({"Jill", "Jim"}) == jill,             "string views", "one (deduced) == char array");
+    check(any({"Catherine", "Jill"}) > "Dave",      "string views", "any (deduced) > C string");
+
+    std::vector<std::string> const pool {"Jill", "Jim", "Jill"};
+    check(one_sv(pool) == jim,                      "string views", "one (pool) == std::string");
+    check(one_sv(pool) == jill,                     "string views", "one (pool) == char array");
+    check(all_sv(pool.begin(), pool.end()) < "K",   "string views", "all (pool iterators) < C string");
+
+    // Hashed copies of C strings hash and compare the characters, not the
+    // pointers:
+    std::vector<char const *> const c_strings {"Jill", "Jim"};
+    MonotonicArena arena;
+    check(any_hash(c_strings) == jill,              "string views", "any_hash (C strings) == char array");
+    check(any_hash(c_strings) == jim,               "string views", "any_hash (C strings) == std::string");
+    check(none_hash({"Fred", "Jim"}) == jill,       "string views", "none_hash (C strings) == char array");
+    check(not(all_hash({"Jill"}) != jill),          "string views", "not(all_hash (C strings) != char array)");
+    check(one_hash(c_strings.begin(), c_strings.end()) == jill, "string views", "one_hash (C string iterators) == char array");
+    check(any_hash(c_strings, arena) == jill,       "string views", "any_hash (C strings, arena) == char array");
+
+    // And so do mutable copies:
+    auto mutable_names = any_mutable({"Fred", "Jim"});
+    check(mutable_names == jim,                     "string views", "any_mutable (C strings) == std::string");
+    mutable_names.Insert("Jill");
+    check(mutable_names == jill,                    "string views", "any_mutable (inserted C string) == char array");
+    check(one_mutable(c_strings) == jill,           "string views", "one_mutable (C strings) == char array");
+    check(all_mutable(c_strings.begin(), c_strings.end()) < "K", "string views", "all_mutable (C string iterators) < C string");
+}
+
+#else
+
+static void check_string_views() { }
+
+#endif
+
+// Interned strings compare by handle with strings from the same table, and by
+// content with everything else:
+
+static void check_interned_strings() {
+    std::vector<std::string> const pool {"Jill", "Jim", "Jill"};
+    auto const jim    = InternTable::Global().Intern("Jim");
+    auto const sheila = InternTable::Global().Intern("Sheila");
+
+    auto const names = any_interned(pool);
+    check(names.GetSize() == 2,                         "interned strings", "duplicates dropped");
+    check(names == jim,                                 "interned strings", "any == interned");
+    check(not(names == sheila),                         "interned strings", "not(any == interned)");
+    check(names == std::string {"Jill"},                "interned strings", "any == std::string");
+    check("Fred" != all_interned(pool),                 "interned strings", "C string != all");
+    check(none_interned({"Fred", "Jim"}) == sheila,     "interned strings", "none == interned");
+    check(one_interned(pool.begin(), pool.end()) == jim, "interned strings", "one (pool iterators) == interned");
+    check(all_interned(pool) < "K",                     "interned strings", "all < C string");
+
+    InternTable local;
+    auto const local_names = all_interned({"Jim", "Jim"}, local);
+    check(local_names == jim,                           "interned strings", "all (local) == interned (global)");
+    check(local.Intern("Jill") == names,                "interned strings", "interned (local) == any (global)");
+
+    auto const shouted = local_names([] (std::string const &name) {return name + '!';});
+    check(shouted == "Jim!",                            "interned strings", "mapped == C string");
+    check(local.GetSize() == 3,                         "interned strings", "mapped strings interned locally");
+
+    auto const lengths = names([] (std::string const &name) {return name.size();});
+    check(lengths == 3u,                                "interned strings", "mapped to lengths");
+}
+
+// Projections read a member of each element in place, unless the elements
+// are copied, in which case only the members are:
+
+struct Order {
+    double      price;
+    unsigned    quantity;
+    std::string symbol;
+
+    double GetTotal() const {
+        return price * quantity;
+    }
+};
+
+static void check_projections() {
+    std::vector<Order> orders {{10.0, 3, "ACME"}, {20.0, 1, "BLAH"}, {15.0, 2, "CORP"}};
+
+    check(any(orders, &Order::price) > 19.0,                       "projections", "any (member) > constant");
+    check(not(all(orders, &Order::price) > 10.0),                  "projections", "not(all (member) > constant)");
+    check(one(orders, &Order::quantity) == 2u,                     "projections", "one (member) == constant");
+    check(none(orders, &Order::symbol) == "DULL",                  "projections", "none (member) == C string");
+    check(any(orders, &Order::GetTotal) == 30.0,                   "projections", "any (method) == constant");
+    check(all(orders, [] (Order const &o) {return o.quantity;}) >= 1u, "projections", "all (lambda) >= constant");
+    check(any(orders.begin(), orders.end(), &Order::price) == 15.0, "projections", "any (iterators) == constant");
+
+    auto const live   = any(orders, &Order::price);
+    auto const copied = any_copy(orders, &Order::price);
+    orders[0].price = 5.0;
+    check(live < 10.0,                                             "projections", "named container is referred to");
+    check(not(copied < 10.0),                                      "projections", "copy keeps its values");
+    check(copied.GetSize() == 3,                                   "projections", "copy holds projected values");
+
+    check(any(std::vector<Order> {{1.0, 1, "TEMP"}}, &Order::price) == 1.0, "projections", "temporary container");
+    check(all(orders, &Order::quantity)([] (unsigned q) {return q * 2;}) <= 6u, "projections", "mapped projection");
+}
+
+// Versioned junctions look values up in a summary of their container, which
+// must still count duplicates for one-junctions, and must follow changes:
+
+static void check_versioned_lookups() {
+    VersionedVector<unsigned> readings {2u, 2u, 5u};
+    auto const any_reading = any_versioned(readings);
+    auto const all_readings = all_versioned(readings);
+    auto const one_reading = one_versioned(readings);
+
+    auto const check_versioned = [] (bool const ok, char const *const test_name) {
+        if (not ok)
+            Outputter() << "Test failed: versioned: " << test_name << '\n';
+    };
+
+    check_versioned(any_reading == 2u and any_reading != 2u,         "any == and != with duplicates");
+    check_versioned(not(all_readings == 2u) and all_readings != 3u,   "all == and != with duplicates");
+    check_versioned(not(one_reading == 2u) and one_reading == 5u,     "one == counts duplicates");
+    check_versioned(not(one_reading != 5u),                           "one != counts duplicates");
+
+    std::vector<unsigned> const same {2u, 2u};
+    readings.Assign(same.begin(), same.end());
+    check_versioned(all_readings == 2u and not(any_reading != 2u),    "summary follows changes");
+    check_versioned(not(any_reading == 5u) and not(one_reading == 2u), "summary drops old values");
+}
+
+// A bitset with an explicit domain rejects elements outside it, rather than
+// writing past its end:
+
+static void check_bitset_domains() {
+    bool rejected {false};
+    try {
+        any_bitset<64> (std::vector<unsigned> {3, 64});
+    }
+    catch (std::out_of_range const &) {
+        rejected = true;
+    }
+
+    if (not rejected)
+        Outputter() << "Test failed: bitsets: element past the domain rejected\n";
+
+    rejected = false;
+    try {
+        all_bitset<8> (std::vector<int> {-1});
+    }
+    catch (std::out_of_range const &) {
+        rejected = true;
+    }
+
+    if (not rejected)
+        Outputter() << "Test failed: bitsets: negative element rejected\n";
+
+    if (not(one_bitset<64> (std::vector<unsigned> {0, 63}) == 63u))
+        Outputter() << "Test failed: bitsets: elements at the ends of the domain\n";
+
+    // Applying a lambda keeps the results in a bitset over the same domain,
+    // even if it widens them, and rejects results outside it:
+    auto const ports = any_bitset<1024> (std::vector<std::uint16_t> {80, 443});
+    auto const next_ports = ports([] (std::uint16_t const port) {return port + 1;});
+    static_assert(std::is_same<decltype(next_ports), AnyOrNone<Details::JunctionBitsetStore<int, 1024>, false> const>::value,
+                  "Mapping an explicit-domain bitset keeps its domain");
+    if (not(next_ports == 444 and not(next_ports == 443)))
+        Outputter() << "Test failed: bitsets: mapped explicit domain\n";
+
+    std::vector<std::uint8_t> const bytes {1, 2, 254};
+    auto const next_bytes = any_copy(bytes)([] (std::uint8_t const b) {return b + 1;});
+    static_assert(std::is_same<decltype(next_bytes), AnyOrNone<Details::JunctionBitsetStore<int, 256>, false> const>::value,
+                  "Mapping a byte bitset into ints keeps it a bitset");
+    if (not(next_bytes == 255 and next_bytes < 3))
+        Outputter() << "Test failed: bitsets: mapped bytes\n";
+
+    rejected = false;
+    try {
+        ports([] (std::uint16_t const port) {return port * 4;});
+    }
+    catch (std::out_of_range const &) {
+        rejected = true;
+    }
+
+    if (not rejected)
+        Outputter() << "Test failed: bitsets: mapped result past the domain rejected\n";
+}
+
+// Sorted ranges whose iterators return proxies, rather than references to
+// their elements, still answer ordering comparisons from their ends:
+
+static void check_proxy_iterators() {
+    std::vector<bool> const flags {false, true, true};
+    check(any(sorted, flags.begin(), flags.end()) > false,          "proxy iterators", "any > lowest");
+    check(not(all(sorted, flags.begin(), flags.end()) > false),     "proxy iterators", "not(all > lowest)");
+    check(all(sorted, flags.begin(), flags.end()) >= false,         "proxy iterators", "all >= lowest");
+    check(none(sorted, flags.begin(), flags.end()) < false,         "proxy iterators", "none < lowest");
+    check(one(sorted, flags.begin(), flags.end()) < true,           "proxy iterators", "one < highest");
+}
+
+// Copies can be made from a single pass over an input stream:
+
+static void check_input_iterators() {
+    std::istringstream copy_in {"5 3 5 9"}, hash_in {"5 3 5 9"};
+    auto const copied = any_copy(std::istream_iterator<int> (copy_in), std::istream_iterator<int> ());
+    auto const hashed = any_hash(std::istream_iterator<int> (hash_in), std::istream_iterator<int> ());
+    if (not(copied == 9 and hashed == 9 and hashed.GetSize() == 3 and not(hashed == 4)))
+        Outputter() << "Test failed: input iterators: copies from a stream\n";
+}
+
+// Ordered stores visit their elements in ascending order, whatever their
+// layout in memory:
+
+static void check_eytzinger_order() {
+    std::vector<int> elements;
+    for (int i = 0;  i < 1000;  ++i)
+        elements.push_back((i * 7919) % 1000);
+
+    auto const junction = any_eytzinger(elements);
+    std::vector<int> visited;
+    for (auto const elem: junction.Elements())
+        visited.push_back(elem);
+
+    if (visited.size() != 1000 or not std::is_sorted(visited.begin(), visited.end()))
+        Outputter() << "Test failed: Eytzinger: elements visited in ascending order\n";
+}
+
+// Column junctions scan in blocks, and so the rows that decide the answer
+// should be found wherever they lie in a block:
+
+static void check_columns() {
+    std::vector<std::int64_t> bids(200), asks(200);
+    for (std::size_t row = 0;  row < bids.size();  ++row) {
+        bids[row] = static_cast<std::int64_t> (row);
+        asks[row] = static_cast<std::int64_t> (row) + 1;
+    }
+
+    check(all_column(bids) < 200,                                "columns", "all < constant");
+    check(not(all_column(bids) < 199),                           "columns", "not(all < constant)");
+    check(any_column(bids) == 130,                               "columns", "any == constant");
+    check(none_column(bids) == -1,                               "columns", "none == constant");
+    check(one_column(bids.data(), bids.size()) == 70,            "columns", "one (pointer) == constant");
+    check(not(one_column(bids) >= 198),                          "columns", "not(one >= constant)");
+    check(all_column(bids) <= all_column(asks.data() + 199, 1),  "columns", "all <= all (cross-product)");
+
+    // Every other value, starting with the second, from a single array of
+    // interleaved bids and asks:
+    std::vector<std::int64_t> interleaved;
+    for (std::size_t row = 0;  row < bids.size();  ++row) {
+        interleaved.push_back(bids[row]);
+        interleaved.push_back(asks[row]);
+    }
+
+    auto const strided_asks = column(interleaved.data() + 1, asks.size(), 2);
+    check(any_column(strided_asks) == 200,                       "columns", "any (strided) == constant");
+    check(not(any_column(strided_asks) == 0),                    "columns", "not(any (strided) == constant)");
+
+    check(all_rows(bids, asks, std::less<> ()),                  "columns", "all rows");
+    check(all_rows(bids, strided_asks, std::less<> ()),          "columns", "all rows (strided)");
+    check(not all_rows(asks, bids, std::less<> ()),              "columns", "not all rows");
+    check(none_rows(asks, bids, std::less<> ()),                 "columns", "none rows");
+    check(not any_rows(asks, bids, std::less<> ()),              "columns", "not any rows");
+
+    asks[150] = bids[150];
+    check(one_rows(asks, bids, std::equal_to<> ()),              "columns", "one row");
+    check(not all_rows(bids, asks, std::less<> ()),              "columns", "not all rows after change");
+
+    // Columns of different lengths are rejected, rather than read past the
+    // end of the shorter one:
+    bool rejected {false};
+    try {
+        any_rows(bids, column(asks.data(), asks.size() - 1), std::less<> ());
+    }
+    catch (std::invalid_argument const &) {
+        rejected = true;
+    }
+
+    check(rejected,                                              "columns", "rows of different lengths rejected");
+}
+
+// Constant junctions are built at compile time, and so every comparison with a
+// single value can be checked by static_assert; the same comparisons are made
+// again with values known only at run time:
+
+constexpr auto small_primes = any_constant(11, 7, 2, 5, 3, 7);
+constexpr auto digits       = all_constant(std::array<int, 10> {{9, 8, 7, 6, 5, 4, 3, 2, 1, 0}});
+
+static_assert(small_primes.GetSize() == 5,                   "constant: duplicates removed");
+static_assert(small_primes == 7 and not(small_primes == 9),  "constant: any ==");
+static_assert(small_primes != 2,                             "constant: any !=");
+static_assert(small_primes < 3 and not(small_primes < 2),    "constant: any <");
+static_assert(small_primes >= 11 and not(small_primes > 11), "constant: any >=, >");
+static_assert(2 <= small_primes and not(12 <= small_primes), "constant: reversed");
+static_assert(not(none_constant(2, 4, 6) != 4),               "constant: none !=");
+static_assert(none_constant(2, 4, 6) == 5,                   "constant: none ==");
+static_assert(digits >= 0 and digits < 10,                   "constant: all, range");
+static_assert(not(digits == 5) and digits != 10,             "constant: all ==, !=");
+static_assert(one_constant(1, 2, 3) < 2,                     "constant: one <");
+static_assert(not(one_constant(1, 2, 3) != 1),               "constant: one !=");
+
+static void check_constant_junctions() {
+    // Enough elements for a binary search:
+    auto const odd = any_constant(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31, 33);
+    for (int i = -1;  i <= 35;  ++i) {
+        check((odd == i) == (i % 2 != 0 and i > 0 and i < 34),  "constants", "any (searched) == value");
+        check((small_primes == i) == (i == 2 or i == 3 or i == 5 or i == 7 or i == 11), "constants", "any == value");
+        check((digits == i) == false,                           "constants", "all (range) == value");
+        check((any_constant(std::array<int, 3> {{4, 6, 5}}) == i) == (i >= 4 and i <= 6), "constants", "any (range) == value");
+    }
+
+    std::vector<int> const values {4, 6, 8};
+    check(none_constant(1, 3, 5) == any_ref(values),   "constants", "none == any");
+    check(small_primes < all_ref(values),              "constants", "any < all");
+    check(not(any_ref(values) == small_primes),        "constants", "not(any == any)");
+    check(one_constant(4, 5) == any_ref(values),       "constants", "one == any");
+
+    enum class Suit {Clubs, Diamonds, Hearts, Spades};
+    auto const red = any_constant(Suit::Hearts, Suit::Diamonds);
+    check(red == Suit::Hearts and red != Suit::Spades, "constants", "any (enums) == value");
+    check(not(red == Suit::Clubs),                     "constants", "not(any (enums) == value)");
+
+    auto sum = 0;
+    for (auto const prime: small_primes.Elements())
+        sum += prime;
+    check(sum == 28,                                   "constants", "elements");
+}
+
+// Enum junctions fold their enumerators into a mask at compile time:
+
+enum class Phase {Connecting, Handshaking, Open, Closing, Closed, Failed};
+
+static_assert(any_enum<Phase, Phase::Open, Phase::Closing>() == Phase::Open,           "enum: any ==");
+static_assert(Phase::Closing == any_enum<Phase, Phase::Open, Phase::Closing>(),        "enum: reversed any ==");
+static_assert(not(any_enum<Phase, Phase::Open, Phase::Closing>() == Phase::Closed),    "enum: not(any ==)");
+static_assert(none_enum<Phase, Phase::Closed, Phase::Failed>() == Phase::Open,         "enum: none ==");
+static_assert(Phase::Failed != one_enum<Phase, Phase::Failed, Phase::Closed>(),        "enum: reversed one !=");
+static_assert(all_enum<Phase, Phase::Open, Phase::Open>() == Phase::Open,              "enum: all ==");
+static_assert(any_enum<Phase, Phase::Open, Phase::Failed>() > Phase::Closed,           "enum: any >");
+static_assert(decltype(any_enum<Phase, Phase::Handshaking, Phase::Closed>())::GetMask() == 0x12, "enum: mask");
+#if __cplusplus >= 201703L
+static_assert(any_enum<Phase::Connecting, Phase::Handshaking>() < Phase::Open,         "enum: any (deduced) <");
+#endif
+
+static void check_enum_junctions() {
+    auto const busy = any_enum<Phase, Phase::Connecting, Phase::Handshaking, Phase::Closing>();
+    auto const done = none_enum<Phase, Phase::Closed, Phase::Failed>();
+    for (auto i = 0;  i <= static_cast<int> (Phase::Failed);  ++i) {
+        auto const phase = static_cast<Phase> (i);
+        check((busy == phase) == (phase == Phase::Connecting or phase == Phase::Handshaking or phase == Phase::Closing), "enums", "any == value");
+        check((phase == busy) == (busy == phase),                                   "enums", "value == any");
+        check((done == phase) == (phase < Phase::Closed),                           "enums", "none == value");
+        check((phase != one_enum<Phase, Phase::Open, Phase::Closed>()) == (phase == Phase::Open or phase == Phase::Closed), "enums", "value != one");
+    }
+
+    check(busy.GetSize() == 3,                                                      "enums", "size");
+    check(any_enum<int, 0, 63>() == 63 and not(any_enum<int, 0, 63>() == 64),       "enums", "integers");
+    check(not(any_enum<int, 0, 63>() == -1),                                        "enums", "negative integer");
+
+    auto last = Phase::Connecting;
+    for (auto const phase: busy.Elements())
+        last = phase;
+    check(last == Phase::Closing,                                                   "enums", "elements in order");
+}
+
+// Mapped files are written to a temporary file first, with and without a
+// header:
+
+#if defined P6_HAVE_MMAP
+
+template<typename T>
+static std::string write_temporary_file(std::vector<T> const &elements, bool const with_header, std::uint32_t const flags) {
+    char path[] {"/tmp/p6junctions-testbed-XXXXXX"};
+    int const fd = ::mkstemp(path);
+    if (fd < 0)
+        return path;
+
+    if (with_header) {
+        Details::MappedFileHeader header;
+        std::memcpy(header.magic, Details::MappedFileHeader::Magic(), sizeof header.magic);
+        header.version = Details::MappedFileHeader::CurrentVersion;
+        header.width   = sizeof(T);
+        header.count   = elements.size();
+        header.kind    = Details::MappedFileHeader::KindOf<T> ();
+        header.flags   = flags;
+        static_cast<void> (::write(fd, &header, sizeof header));
+    }
+
+    static_cast<void> (::write(fd, elements.data(), elements.size() * sizeof(T)));
+    ::close(fd);
+    return path;
+}
+
+static void check_mapped_files() {
+    std::vector<std::uint64_t> const ids {5, 9, 12, 40};
+    auto const sorted_and_unique = Details::MappedFileHeader::Sorted | Details::MappedFileHeader::Unique;
+
+    auto const bare = write_temporary_file(ids, false, 0);
+    check(any_mapped<std::uint64_t> (bare) == 12u,                 "mapped files", "any (no header) == constant");
+    check(not(all_mapped<std::uint64_t> (bare) < 40u),             "mapped files", "not(all (no header) < constant)");
+    check(one_mapped<std::uint64_t> (sorted, bare) == 9u,          "mapped files", "one (no header, sorted) == constant");
+    check(all_mapped<std::uint64_t> (sorted, bare) >= 5u,          "mapped files", "all (no header, sorted) >= constant");
+
+    auto const headed = write_temporary_file(ids, true, sorted_and_unique);
+    auto const mapped = none_mapped<std::uint64_t> (sorted, headed);
+    check(mapped == 13u,                                           "mapped files", "none (header, sorted) == constant");
+    check(not(mapped > 39u),                                       "mapped files", "not(none (header, sorted) > constant)");
+    check(mapped.GetSize() == 4,                                   "mapped files", "size from header");
+
+    bool rejected {false};
+    try {
+        any_mapped<std::int64_t> (headed);
+    }
+    catch (std::runtime_error const &) {
+        rejected = true;
+    }
+
+    check(rejected,                                                "mapped files", "wrong element type rejected");
+
+    auto const unsorted = write_temporary_file(std::vector<double> {2.5, 1.5}, true, 0);
+    rejected = false;
+    try {
+        any_mapped<double> (sorted, unsorted);
+    }
+    catch (std::runtime_error const &) {
+        rejected = true;
+    }
+
+    check(rejected,                                                "mapped files", "unsorted header rejected");
+    check(any_mapped<double> (unsorted) < 2.0,                     "mapped files", "any (doubles) < constant");
+
+    ::unlink(bare.c_str());
+    ::unlink(headed.c_str());
+    ::unlink(unsorted.c_str());
+}
+
+// Snapshots are saved and then both loaded and mapped:
+
+static void check_snapshots() {
+    auto const path = write_temporary_file(std::vector<std::int32_t> {}, false, 0);
+
+    std::vector<std::int32_t> limits;
+    for (std::int32_t limit = 1000;  limit > -1000;  limit -= 3)
+        limits.push_back(limit);
+
+    std::vector<std::int32_t> const ascending(limits.rbegin(), limits.rend());
+    for (bool const with_index: {false, true}) {
+        Save(any_copy(limits), path, with_index);
+        auto const loaded = all_load<std::int32_t> (path);
+        auto const mapped = any_mapped<std::int32_t> (sorted, path);
+
+        check(Load<std::int32_t> (path) == ascending,               "mapped files", "loaded in ascending order");
+        check(loaded.GetSize() == limits.size(),                    "mapped files", "loaded size");
+        check(loaded >= -998 and not(loaded >= -997),               "mapped files", "loaded >= constant");
+        check(mapped == 1000 and mapped == -998,                    "mapped files", "mapped == constant");
+        check(not(mapped == 999) and not(mapped == -999),           "mapped files", "not(mapped == constant)");
+        check(none_mapped<std::int32_t> (sorted, path) == 5,        "mapped files", "none (mapped) == constant");
+        check(one_mapped<std::int32_t> (sorted, path) == 1000,      "mapped files", "one (mapped) == constant");
+    }
+
+    bool rejected {false};
+    try {
+        Load<std::uint32_t> (path);
+    }
+    catch (std::runtime_error const &) {
+        rejected = true;
+    }
+
+    check(rejected,                                                 "mapped files", "load with wrong element type rejected");
+    ::unlink(path.c_str());
+}
+
+// A shared junction is published under a name unique to this process, and
+// replaced by a second generation while the first is still attached:
+
+static void check_shared_junctions() {
+    auto const name = "/p6-testbed-" + std::to_string(::getpid());
+
+    std::vector<std::uint64_t> ids;
+    for (std::uint64_t id = 0;  id < 3000;  id += 3)
+        ids.push_back(id);
+
+    check(Publish(any_copy(ids), name) == 1,                        "mapped files", "first generation");
+    auto deny = any_shared<std::uint64_t> (name);
+    check(deny == 2997u and not(deny == 2998u),                     "mapped files", "shared == constant");
+    check(deny.GetSize() == ids.size() and deny.IsCurrent(),        "mapped files", "shared size and generation");
+    check(none_shared<std::uint64_t> (name) == 1u,                  "mapped files", "none (shared) == constant");
+    check(all_shared<std::uint64_t> (name) < 3000u,                 "mapped files", "all (shared) < constant");
+
+    ids.push_back(1);
+    check(Publish(one_ref(ids), name) == 2,                         "mapped files", "second generation");
+    check(not deny.IsCurrent() and not(deny == 1u),                 "mapped files", "old generation unchanged");
+
+    deny = any_shared<std::uint64_t> (name);
+    check(deny.GetGeneration() == 2 and deny == 1u,                 "mapped files", "new generation attached");
+    check(one_shared<std::uint64_t> (name) == 1u,                   "mapped files", "one (shared) == constant");
+
+    bool rejected {false};
+    try {
+        any_shared<std::uint32_t> (name);
+    }
+    catch (std::runtime_error const &) {
+        rejected = true;
+    }
+
+    check(rejected,                                                 "mapped files", "shared with wrong element type rejected");
+
+    Unpublish(name);
+    check(deny == 2997u,                                            "mapped files", "attached junction outlives its name");
+    check(not deny.IsCurrent(),                                     "mapped files", "unpublished junction not current");
+
+    rejected = false;
+    try {
+        any_shared<std::uint64_t> (name);
+    }
+    catch (std::system_error const &) {
+        rejected = true;
+    }
+
+    check(rejected,                                                 "mapped files", "unpublished name rejected");
+
+    // Publishing the name again starts afresh, and a junction attached before
+    // it was unpublished moves on to the new elements:
+    check(Publish(any_copy(std::vector<std::uint64_t> {5, 7}), name) == 1, "mapped files", "republished");
+    check(not deny.IsCurrent(),                                     "mapped files", "republished junction not current");
+    if (not deny.IsCurrent())
+        deny = any_shared<std::uint64_t> (name);
+
+    check(deny.IsCurrent() and deny == 7u and not(deny == 2997u),   "mapped files", "republished elements attached");
+    Unpublish(name);
+}
+
+#else
+
+static void check_mapped_files() { }
+static void check_snapshots() { }
+static void check_shared_junctions() { }
+
+#endif
+
 }   // Escape from namespace P6
 
 int main() {
     P6::check_creation_types();
     P6::compare_junctions_with_constants();
     P6::compare_junctions_with_junctions();
+    P6::check_string_views();
+    P6::check_interned_strings();
+    P6::check_projections();
+    P6::check_versioned_lookups();
+    P6::check_bitset_domains();
+    P6::check_proxy_iterators();
+    P6::check_input_iterators();
+    P6::check_eytzinger_order();
+    P6::check_columns();
+    P6::check_constant_junctions();
+    P6::check_enum_junctions();
+    P6::check_mapped_files();
+    P6::check_snapshots();
+    P6::check_shared_junctions();
     return 0;
 }
 